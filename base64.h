@@ -3,64 +3,244 @@
 #define BASE64_H
 #include<string>
 #include<vector>
+#include<cstdint>
+#include<cstring>
+#include "instrumentation.h"
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BASE64_X86_SIMD 1
+#include<immintrin.h>
+#endif
 
 namespace Base64{
   static const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-  // Encodes binary data to Base64 string
-  inline std::string encode(const std::vector<unsigned char>& data){
-    std::string ret;
-    int i=0;
-    unsigned char arr3[3], arr4[4];
-    for(size_t n=0; n<data.size(); n++){
-      arr3[i++] = data[n];
-      if(i==3){
-        arr4[0] = (arr3[0] & 0xfc) >> 2;
-        arr4[1] = ((arr3[0] & 0x03) << 4) + ((arr3[1] & 0xf0) >> 4);
-        arr4[2] = ((arr3[1] & 0x0f) << 2) + ((arr3[2] & 0xc0) >> 6);
-        arr4[3] = arr3[2] & 0x3f;
-        for(int j=0; j<4; j++) ret += chars[arr4[j]];
-        i = 0;
+  namespace detail{
+    static const unsigned char INVALID = 0xFF;
+
+    // 256-entry reverse lookup table, INVALID for characters outside the alphabet
+    struct DecodeTable{
+      unsigned char values[256];
+      constexpr DecodeTable() : values(){
+        const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for(int i=0; i<256; i++) values[i] = INVALID;
+        for(int i=0; i<64; i++) values[static_cast<unsigned char>(alphabet[i])] = i;
+      }
+    };
+    static constexpr DecodeTable decodeTable{};
+    static constexpr char encodeTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Encodes whole 3-byte groups and the padded tail; out must hold encodedLength(size) chars
+    inline void encodeScalar(const unsigned char* in, size_t size, char* out){
+      size_t n = 0;
+      for(; n+3<=size; n+=3){
+        uint32_t group = (in[n]<<16) | (in[n+1]<<8) | in[n+2];
+        *out++ = encodeTable[(group>>18) & 0x3F];
+        *out++ = encodeTable[(group>>12) & 0x3F];
+        *out++ = encodeTable[(group>>6) & 0x3F];
+        *out++ = encodeTable[group & 0x3F];
+      }
+      size_t rest = size-n;
+      if(rest){
+        uint32_t group = in[n]<<16;
+        if(rest==2) group |= in[n+1]<<8;
+        *out++ = encodeTable[(group>>18) & 0x3F];
+        *out++ = encodeTable[(group>>12) & 0x3F];
+        *out++ = rest==2 ? encodeTable[(group>>6) & 0x3F] : '=';
+        *out++ = '=';
+      }
+    }
+
+    // Decodes until the first '=' skipping characters outside the alphabet; returns bytes written
+    inline size_t decodeScalar(const char* in, size_t size, unsigned char* out){
+      unsigned char* start = out;
+      uint32_t group = 0;
+      int count = 0;
+      for(size_t n=0; n<size && in[n]!='='; n++){
+        unsigned char value = decodeTable.values[static_cast<unsigned char>(in[n])];
+        if(value==INVALID) continue;
+        group = (group<<6) | value;
+        if(++count==4){
+          *out++ = group>>16;
+          *out++ = group>>8;
+          *out++ = group;
+          group = 0;
+          count = 0;
+        }
+      }
+      // Handle remaining characters: 2 -> 1 byte, 3 -> 2 bytes, a single one carries no full byte
+      if(count>=2){
+        group <<= 6*(4-count);
+        *out++ = group>>16;
+        if(count==3) *out++ = group>>8;
+      }
+      return out-start;
+    }
+
+#ifdef BASE64_X86_SIMD
+    // Vectorized paths after Mula and Lemire. Each consumes whole blocks only and returns how many
+    // input bytes it handled; the scalar code finishes the tail and anything the SIMD check rejects.
+
+    __attribute__((target("ssse3"))) inline __m128i encodeLanes128(__m128i in){
+      in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+      __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+      __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+      __m128i indices = _mm_or_si128(t0, t1);
+      // Map 6-bit values to ASCII by adding a per-range offset
+      __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+      __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+      range = _mm_sub_epi8(range, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+      return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+    }
+
+    __attribute__((target("ssse3"))) inline size_t encodeSSSE3(const unsigned char* in, size_t size, char* out){
+      size_t n = 0;
+      for(; n+16<=size; n+=12, out+=16){  // Reads 16 bytes, uses 12
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in+n));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), encodeLanes128(block));
+      }
+      return n;
+    }
+
+    __attribute__((target("avx2"))) inline size_t encodeAVX2(const unsigned char* in, size_t size, char* out){
+      const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                               1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+      const __m256i offsets = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                               65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+      size_t n = 0;
+      for(; n+28<=size; n+=24, out+=32){  // Two 16-byte loads 12 bytes apart, 24 bytes used
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in+n));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in+n+12));
+        __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        block = _mm256_shuffle_epi8(block, shuffle);
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(block, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(block, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(t0, t1);
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range)));
+      }
+      return n;
+    }
+
+    // Validates 16 characters and converts them to 6-bit values; returns false if any is outside the alphabet
+    __attribute__((target("ssse3"))) inline bool decodeLanes128(__m128i& block){
+      const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+      const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+      const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      const __m128i mask2F = _mm_set1_epi8(0x2f);
+      __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(block, 4), mask2F);
+      __m128i lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(block, mask2F));
+      __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+      __m128i invalid = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+      if(_mm_movemask_epi8(invalid)!=0xFFFF) return false;
+      __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(block, mask2F), hiNibbles));
+      block = _mm_add_epi8(block, roll);
+      return true;
+    }
+
+    __attribute__((target("ssse3"))) inline size_t decodeSSSE3(const char* in, size_t size, unsigned char* out, size_t& written){
+      size_t n = 0;
+      written = 0;
+      for(; n+16<=size; n+=16, written+=12){  // Stores 16 bytes, 12 valid; caller leaves slack
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in+n));
+        if(!decodeLanes128(block)) break;
+        block = _mm_maddubs_epi16(block, _mm_set1_epi32(0x01400140));
+        block = _mm_madd_epi16(block, _mm_set1_epi32(0x00011000));
+        block = _mm_shuffle_epi8(block, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out+written), block);
+      }
+      return n;
+    }
+
+    __attribute__((target("avx2"))) inline size_t decodeAVX2(const char* in, size_t size, unsigned char* out, size_t& written){
+      const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                             0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+      const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+      const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                               0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      const __m256i mask2F = _mm256_set1_epi8(0x2f);
+      size_t n = 0;
+      written = 0;
+      for(; n+32<=size; n+=32, written+=24){  // Stores 32 bytes, 24 valid; caller leaves slack
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in+n));
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(block, 4), mask2F);
+        __m256i lo = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(block, mask2F));
+        __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        if(!_mm256_testz_si256(lo, hi)) break;  // Invalid character or padding, leave it to the scalar path
+        __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(block, mask2F), hiNibbles));
+        block = _mm256_add_epi8(block, roll);
+        block = _mm256_maddubs_epi16(block, _mm256_set1_epi32(0x01400140));
+        block = _mm256_madd_epi16(block, _mm256_set1_epi32(0x00011000));
+        block = _mm256_shuffle_epi8(block, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        block = _mm256_permutevar8x32_epi32(block, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+written), block);
       }
+      return n;
+    }
+
+    enum class Isa{ SCALAR, SSSE3, AVX2 };
+
+    // Detects the best supported instruction set once
+    inline Isa cpuIsa(){
+      static const Isa isa = [](){
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return Isa::AVX2;
+        if(__builtin_cpu_supports("ssse3")) return Isa::SSSE3;
+        return Isa::SCALAR;
+      }();
+      return isa;
+    }
+#endif
+  }
+
+  // Number of Base64 characters needed for size bytes, including padding
+  inline size_t encodedLength(size_t size){
+    return (size+2)/3*4;
+  }
+
+  // Encodes size bytes into out, which must hold encodedLength(size) chars
+  inline void encodeInto(const unsigned char* data, size_t size, char* out){
+    STATS_TIMER("base64.encode");
+    STATS_COUNT("base64.encode_bytes", size);
+    size_t done = 0;
+#ifdef BASE64_X86_SIMD
+    switch(detail::cpuIsa()){
+      case detail::Isa::AVX2: done = detail::encodeAVX2(data, size, out); break;
+      case detail::Isa::SSSE3: done = detail::encodeSSSE3(data, size, out); break;
+      default: break;
     }
-    // Handle remaining bytes
-    if(i){
-      for(int j=i; j<3; j++) arr3[j] = '\0';
-      arr4[0] = (arr3[0] & 0xfc) >> 2;
-      arr4[1] = ((arr3[0] & 0x03) << 4) + ((arr3[1] & 0xf0) >> 4);
-      arr4[2] = ((arr3[1] & 0x0f) << 2) + ((arr3[2] & 0xc0) >> 6);
-      for(int j=0; j<i+1; j++) ret += chars[arr4[j]];
-      while(i++<3) ret += '=';  // Add padding
+#endif
+    detail::encodeScalar(data+done, size-done, out+done/3*4);
+  }
+
+  // Decodes str into out, which must hold size/4*3+32 bytes; returns bytes written
+  inline size_t decodeInto(const char* str, size_t size, unsigned char* out){
+    STATS_TIMER("base64.decode");
+    STATS_COUNT("base64.decode_bytes", size);
+    size_t consumed = 0, written = 0;
+#ifdef BASE64_X86_SIMD
+    switch(detail::cpuIsa()){
+      case detail::Isa::AVX2: consumed = detail::decodeAVX2(str, size, out, written); break;
+      case detail::Isa::SSSE3: consumed = detail::decodeSSSE3(str, size, out, written); break;
+      default: break;
     }
+#endif
+    return written + detail::decodeScalar(str+consumed, size-consumed, out+written);
+  }
+
+  // Encodes binary data to Base64 string
+  inline std::string encode(const std::vector<unsigned char>& data){
+    std::string ret(encodedLength(data.size()), '\0');
+    encodeInto(data.data(), data.size(), &ret[0]);
     return ret;
   }
 
   // Decodes Base64 string to binary data
   inline std::vector<unsigned char> decode(const std::string& str){
-    int i=0;
-    unsigned char arr4[4], arr3[3];
-    std::vector<unsigned char> ret;
-    for(size_t n=0; n<str.length() && str[n]!='='; n++){
-      size_t pos = chars.find(str[n]);
-      if(pos==std::string::npos) continue;
-      arr4[i++] = str[n];
-      if(i==4){
-        for(int j=0; j<4; j++) arr4[j] = chars.find(arr4[j]);
-        arr3[0] = (arr4[0] << 2) + ((arr4[1] & 0x30) >> 4);
-        arr3[1] = ((arr4[1] & 0xf) << 4) + ((arr4[2] & 0x3c) >> 2);
-        arr3[2] = ((arr4[2] & 0x3) << 6) + arr4[3];
-        for(int j=0; j<3; j++) ret.push_back(arr3[j]);
-        i = 0;
-      }
-    }
-    // Handle remaining bytes
-    if(i){
-      for(int j=i; j<4; j++) arr4[j] = 0;
-      for(int j=0; j<4; j++) arr4[j] = chars.find(arr4[j]);
-      arr3[0] = (arr4[0] << 2) + ((arr4[1] & 0x30) >> 4);
-      arr3[1] = ((arr4[1] & 0xf) << 4) + ((arr4[2] & 0x3c) >> 2);
-      for(int j=0; j<i-1; j++) ret.push_back(arr3[j]);
-    }
+    std::vector<unsigned char> ret(str.size()/4*3+32);  // Slack for full-width SIMD stores
+    ret.resize(decodeInto(str.data(), str.size(), ret.data()));
     return ret;
   }
 }
@@ -0,0 +1,273 @@
+// passanomix_bench.cpp
+// Microbenchmarks for the hot paths. Results go to the console and, unless --benchmark_out is given,
+// to passanomix_bench.json so runs can be compared across commits (e.g. with compare.py from Google Benchmark).
+#include<benchmark/benchmark.h>
+#include<string>
+#include<vector>
+#include<map>
+#include<cstdlib>
+#include<cstring>
+#include<unistd.h>
+#include "password_generator.h"
+#include "base64.h"
+#include "encryption.h"
+#include "password_storage.h"
+#include "bulk_provisioner.h"
+
+namespace{
+  const char* const MASTER = "benchmark-master-password";
+
+  std::string& scratchDir(){
+    static std::string dir = [](){
+      char pattern[] = "/tmp/passanomix-bench-XXXXXX";
+      if(!::mkdtemp(pattern)) throw std::runtime_error("Can't create scratch directory");
+      return std::string(pattern);
+    }();
+    return dir;
+  }
+
+  // Returns the path of a synthetic vault with count entries, creating it on first use
+  const std::string& syntheticVault(size_t count, bool binary){
+    static std::map<std::pair<size_t, bool>, std::string> vaults;
+    auto key = std::make_pair(count, binary);
+    auto it = vaults.find(key);
+    if(it!=vaults.end()) return it->second;
+    std::string path = scratchDir()+"/vault-"+std::to_string(count)+(binary ? BinaryVault::EXTENSION : ".json");
+    std::vector<ProvisionSpec> specs(count);
+    for(size_t i=0; i<count; i++){
+      specs[i].service = "service-"+std::to_string(i);
+      specs[i].username = "user"+std::to_string(i)+"@example.com";
+      specs[i].notes = i%4==0 ? "synthetic entry" : "";
+    }
+    PasswordStorage storage(path, MASTER);
+    BulkProvisioner::provision(storage, specs);
+    return vaults[key] = path;
+  }
+
+  void removeScratchDir(){
+    std::string command = "rm -rf '"+scratchDir()+"'";
+    if(std::system(command.c_str())!=0) std::fprintf(stderr, "Couldn't remove %s\n", scratchDir().c_str());
+  }
+
+  // Vault sizes x {JSON, binary}
+  void vaultArgs(benchmark::internal::Benchmark* b){
+    b->ArgsProduct({{100, 10000, 1000000}, {0, 1}})->ArgNames({"entries", "binary"})->Unit(benchmark::kMillisecond);
+  }
+}
+
+static void BM_Generate(benchmark::State& state){
+  PasswordGenerator generator;
+  for(auto _ : state){
+    benchmark::DoNotOptimize(generator.generate(state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Generate)->Arg(12)->Arg(16)->Arg(64);
+
+static void BM_GenerateBatch(benchmark::State& state){
+  PasswordGenerator generator;
+  for(auto _ : state){
+    benchmark::DoNotOptimize(generator.generateBatch(1000, 16));
+  }
+  state.SetItemsProcessed(state.iterations()*1000);
+}
+BENCHMARK(BM_GenerateBatch);
+
+// 1000 six-word passphrases into one buffer, like BM_GenerateBatch
+static void BM_GeneratePassphraseBatch(benchmark::State& state){
+  PasswordGenerator generator;
+  PasswordGenerator::PassphraseSpec spec;
+  spec.capitalization = static_cast<PasswordGenerator::Capitalization>(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(generator.generatePassphraseBatch(1000, spec));
+  }
+  state.SetItemsProcessed(state.iterations()*1000);
+}
+BENCHMARK(BM_GeneratePassphraseBatch)->Arg(PasswordGenerator::LOWER)->Arg(PasswordGenerator::RANDOM_CASE);
+
+static void BM_CalculateStrength(benchmark::State& state){
+  PasswordGenerator generator;
+  std::vector<SecureString> passwords = {"password", "Password1234!", generator.generate(16), generator.generate(32)};
+  size_t i = 0;
+  for(auto _ : state){
+    benchmark::DoNotOptimize(generator.calculateStrength(passwords[i++ & 3]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateStrength);
+
+static void BM_Base64Encode(benchmark::State& state){
+  auto data = Encryption::randomBytes(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(Base64::encode(data));
+  }
+  state.SetBytesProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_Base64Encode)->Arg(32)->Arg(4096)->Arg(1<<20);
+
+static void BM_Base64Decode(benchmark::State& state){
+  std::string encoded = Base64::encode(Encryption::randomBytes(state.range(0)));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(Base64::decode(encoded));
+  }
+  state.SetBytesProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_Base64Decode)->Arg(32)->Arg(4096)->Arg(1<<20);
+
+// KDF half of Encryption::encrypt/decrypt: one PBKDF2 run, paid per entry by legacy entries and once per unlock otherwise
+static void BM_KeyDerivation(benchmark::State& state){
+  auto salt = Encryption::randomBytes(Encryption::SALT_SIZE);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(Encryption::deriveMasterKey(MASTER, salt, state.range(0)));
+  }
+}
+BENCHMARK(BM_KeyDerivation)->Arg(Encryption::ITERATIONS)->Unit(benchmark::kMillisecond);
+
+// Cipher half: subkey expansion plus encryption of a 16-character password, per cipher
+static void BM_CipherEncrypt(benchmark::State& state){
+  auto cipher = static_cast<Encryption::Cipher>(state.range(0));
+  auto master = Encryption::randomBytes(Encryption::KEY_SIZE);
+  auto id = Encryption::randomBytes(Encryption::ENTRY_ID_SIZE);
+  unsigned char key[Encryption::KEY_SIZE], iv[Encryption::IV_SIZE] = {}, out[64];
+  const unsigned char plaintext[] = "Tr0ub4dor&3xyzw!";
+  Encryption::Session session;
+  for(auto _ : state){
+    Encryption::deriveEntryKeyInto(master.data(), master.size(), id.data(), id.size(), key);
+    benchmark::DoNotOptimize(session.encryptInto(cipher, key, iv, id.data(), id.size(), plaintext, 16, out, sizeof(out)));
+  }
+  state.SetLabel(Encryption::cipherName(cipher)[0] ? Encryption::cipherName(cipher) : "aes-256-cbc");
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CipherEncrypt)->DenseRange(0, Encryption::CIPHER_COUNT-1);
+
+static void BM_CipherDecrypt(benchmark::State& state){
+  auto cipher = static_cast<Encryption::Cipher>(state.range(0));
+  auto master = Encryption::randomBytes(Encryption::KEY_SIZE);
+  auto id = Encryption::randomBytes(Encryption::ENTRY_ID_SIZE);
+  unsigned char key[Encryption::KEY_SIZE], iv[Encryption::IV_SIZE] = {}, sealed[64], out[80];
+  const unsigned char plaintext[] = "Tr0ub4dor&3xyzw!";
+  Encryption::Session session;
+  Encryption::deriveEntryKeyInto(master.data(), master.size(), id.data(), id.size(), key);
+  size_t len = session.encryptInto(cipher, key, iv, id.data(), id.size(), plaintext, 16, sealed, sizeof(sealed));
+  for(auto _ : state){
+    Encryption::deriveEntryKeyInto(master.data(), master.size(), id.data(), id.size(), key);
+    benchmark::DoNotOptimize(session.decryptInto(cipher, key, iv, id.data(), id.size(), sealed, len, out, sizeof(out)));
+  }
+  state.SetLabel(Encryption::cipherName(cipher)[0] ? Encryption::cipherName(cipher) : "aes-256-cbc");
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CipherDecrypt)->DenseRange(0, Encryption::CIPHER_COUNT-1);
+
+// Legacy Encryption::encrypt/decrypt end to end, KDF included
+static void BM_LegacyEncrypt(benchmark::State& state){
+  for(auto _ : state){
+    benchmark::DoNotOptimize(Encryption::encrypt("Tr0ub4dor&3xyzw!", MASTER));
+  }
+}
+BENCHMARK(BM_LegacyEncrypt)->Unit(benchmark::kMillisecond);
+
+static void BM_LegacyDecrypt(benchmark::State& state){
+  auto sealed = Encryption::encrypt("Tr0ub4dor&3xyzw!", MASTER);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(Encryption::decrypt(sealed, MASTER));
+  }
+}
+BENCHMARK(BM_LegacyDecrypt)->Unit(benchmark::kMillisecond);
+
+static void BM_VaultLoad(benchmark::State& state){
+  const std::string& path = syntheticVault(state.range(0), state.range(1));
+  for(auto _ : state){
+    PasswordStorage storage(path, MASTER);
+    storage.load();
+    benchmark::DoNotOptimize(storage.getEntryCount());
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_VaultLoad)->Apply(vaultArgs);
+
+static void BM_VaultSave(benchmark::State& state){
+  const std::string& path = syntheticVault(state.range(0), state.range(1));
+  PasswordStorage storage(path, MASTER);
+  storage.load();
+  storage.unlock();
+  for(auto _ : state){
+    storage.save();
+  }
+  state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_VaultSave)->Apply(vaultArgs);
+
+// Lookup and decryption of one entry in an unlocked vault, cycling through services
+static void BM_VaultGetPassword(benchmark::State& state){
+  size_t count = state.range(0);
+  const std::string& path = syntheticVault(count, state.range(1));
+  PasswordStorage storage(path, MASTER);
+  storage.load();
+  storage.unlock();
+  std::vector<std::string> services(1024);
+  for(size_t i=0; i<services.size(); i++) services[i] = "service-"+std::to_string(i*7919%count);
+  size_t i = 0;
+  for(auto _ : state){
+    benchmark::DoNotOptimize(storage.getPassword(services[i++ & 1023]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VaultGetPassword)->Apply([](benchmark::internal::Benchmark* b){
+  b->ArgsProduct({{100, 10000, 1000000}, {0, 1}})->ArgNames({"entries", "binary"});
+});
+
+// Top-10 trigram search over service, username and notes; nothing is decrypted
+static void BM_VaultSearch(benchmark::State& state){
+  PasswordStorage storage(syntheticVault(state.range(0), state.range(1)), MASTER);
+  storage.load();
+  const char* queries[] = {"service-4217", "user99@exmaple", "synthetic", "srvice-12"};
+  size_t i = 0;
+  for(auto _ : state){
+    benchmark::DoNotOptimize(storage.search(queries[i++ & 3], 10));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VaultSearch)->Apply([](benchmark::internal::Benchmark* b){
+  b->ArgsProduct({{100, 10000, 100000}, {0, 1}})->ArgNames({"entries", "binary"})->Unit(benchmark::kMicrosecond);
+});
+
+// One 50-entry page sorted by service at a cycling offset; the sort itself is paid once, before timing
+static void BM_VaultListPage(benchmark::State& state){
+  size_t count = state.range(0);
+  PasswordStorage storage(syntheticVault(count, state.range(1)), MASTER);
+  storage.load();
+  PasswordStorage::ListQuery query;
+  query.order = PasswordStorage::BY_SERVICE;
+  query.limit = 50;
+  storage.listPage(query, [](const EntryMeta&){});
+  size_t i = 0;
+  for(auto _ : state){
+    query.offset = i++*7919%count;
+    storage.listPage(query, [](const EntryMeta& e){ benchmark::DoNotOptimize(e.service.data()); });
+  }
+  state.SetItemsProcessed(state.iterations()*50);
+}
+BENCHMARK(BM_VaultListPage)->Apply([](benchmark::internal::Benchmark* b){
+  b->ArgsProduct({{100, 10000, 1000000}, {0, 1}})->ArgNames({"entries", "binary"})->Unit(benchmark::kMicrosecond);
+});
+
+int main(int argc, char** argv){
+  std::vector<char*> args(argv, argv+argc);
+  bool hasOut = false;
+  for(int i=1; i<argc; i++){
+    if(std::strncmp(argv[i], "--benchmark_out=", 16)==0) hasOut = true;
+  }
+  std::string out = "--benchmark_out=passanomix_bench.json";
+  std::string format = "--benchmark_out_format=json";
+  if(!hasOut){
+    args.push_back(&out[0]);
+    args.push_back(&format[0]);
+  }
+  int count = args.size();
+  benchmark::Initialize(&count, args.data());
+  if(benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  removeScratchDir();
+  return 0;
+}
@@ -0,0 +1,274 @@
+// binary_vault.h
+#ifndef BINARY_VAULT_H
+#define BINARY_VAULT_H
+#include<string>
+#include<string_view>
+#include<vector>
+#include<cstring>
+#include<cstdint>
+#include<stdexcept>
+#include<algorithm>
+#include "base64.h"
+#include "encryption.h"
+#include "durable_file.h"
+#include "mapped_file.h"
+#include "password_entry.h"
+
+// Compact binary vault container, memory-mapped and read one record at a time.
+//
+// Layout (little-endian):
+//   header   80 bytes (64 before version 3): magic, format version, KDF iterations, generation, entry count,
+//            legacy entry count, salt, master key check value (all zero if the vault was written without one),
+//            then KDF algorithm (Encryption::Kdf), memory cost in KiB, parallelism and 4 reserved bytes
+//            (absent before version 3, which is PBKDF2-SHA256 only)
+//   offsets  entry count x u64: file offset of each record, in entry order
+//   lookup   entry count x (u64 service hash, u64 entry index), sorted by hash
+//   records  per entry, a cipher version byte (Encryption::Cipher; absent in version 1 files, which are all CBC)
+//            followed by 8 length-prefixed fields (u32 length + bytes); salt/iv/ciphertext/id are raw bytes
+class BinaryVault{
+public:
+  static constexpr const char* EXTENSION = ".pvault";
+  static const uint32_t FORMAT_VERSION = 3;
+  static const size_t HEADER_SIZE = 80;
+  static const size_t V2_HEADER_SIZE = 64;
+  static const size_t SALT_SIZE = 16;
+
+  struct Header{
+    Encryption::KdfParams kdf;
+    uint64_t generation = 0;
+    uint64_t entryCount = 0;
+    uint64_t legacyCount = 0;   // Entries still using per-entry PBKDF2 salts
+    std::vector<unsigned char> salt;
+    std::vector<unsigned char> keyCheck;  // Empty if the vault has no key check value
+  };
+
+  // Fields of one record as slices of the mapped file
+  struct Record{
+    Encryption::Cipher cipher = Encryption::CBC;
+    std::string_view id, service, username, ciphertext, salt, iv, timestamp, notes;
+  };
+
+private:
+  static constexpr char MAGIC[8] = {'P', 'N', 'X', 'V', 'A', 'U', 'L', 'T'};
+  MappedFile file;
+  Header header;
+  uint32_t version = FORMAT_VERSION;
+  size_t headerSize = HEADER_SIZE;
+
+  // Reads a little-endian integer of the given width
+  static uint64_t getLE(const char* p, int bytes){
+    uint64_t value = 0;
+    for(int i=bytes-1; i>=0; i--) value = (value<<8) | static_cast<unsigned char>(p[i]);
+    return value;
+  }
+
+  static uint64_t get64(const char* p){
+    return getLE(p, 8);
+  }
+
+  static uint32_t get32(const char* p){
+    return static_cast<uint32_t>(getLE(p, 4));
+  }
+
+  static void put64(std::string& out, uint64_t value){
+    for(int i=0; i<8; i++) out += static_cast<char>((value>>(8*i)) & 0xFF);
+  }
+
+  static void put32(std::string& out, uint32_t value){
+    for(int i=0; i<4; i++) out += static_cast<char>((value>>(8*i)) & 0xFF);
+  }
+
+  static void putField(std::string& out, const std::string& bytes){
+    put32(out, bytes.size());
+    out += bytes;
+  }
+
+  static void putRawField(std::string& out, const std::vector<unsigned char>& bytes){
+    put32(out, bytes.size());
+    out.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  }
+
+  [[noreturn]] static void corrupted(){
+    throw std::runtime_error("Corrupted binary vault");
+  }
+
+  static std::string toBase64(std::string_view raw){
+    std::string encoded(Base64::encodedLength(raw.size()), '\0');
+    Base64::encodeInto(reinterpret_cast<const unsigned char*>(raw.data()), raw.size(), &encoded[0]);
+    return encoded;
+  }
+
+  // Returns the (hash, index) lookup slot at position i
+  const char* lookupSlot(size_t i) const{
+    return file.data() + headerSize + header.entryCount*8 + i*16;
+  }
+
+public:
+  // FNV-1a hash of the case-folded service, used to order the lookup table
+  static uint64_t serviceHash(const std::string& service){
+    uint64_t hash = 1469598103934665603ULL;
+    for(unsigned char c : foldCase(service)){
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  // Maps a binary vault; returns false if the file doesn't exist or isn't a binary vault
+  bool open(const std::string& path){
+    if(!file.open(path, false)) return false;
+    if(file.size()<V2_HEADER_SIZE || std::memcmp(file.data(), MAGIC, sizeof(MAGIC))!=0){
+      file.close();
+      return false;
+    }
+    const char* p = file.data();
+    version = get32(p+8);
+    if(version<1 || version>FORMAT_VERSION){
+      throw std::runtime_error("Unsupported binary vault version");
+    }
+    headerSize = version>=3 ? HEADER_SIZE : V2_HEADER_SIZE;
+    if(file.size()<headerSize) corrupted();
+    header.kdf = Encryption::KdfParams();
+    header.kdf.iterations = get32(p+12);
+    if(version>=3){
+      header.kdf.algorithm = Encryption::kdfFromByte(get32(p+64));
+      header.kdf.memoryKiB = get32(p+68);
+      header.kdf.parallelism = get32(p+72);
+    }
+    header.generation = get64(p+16);
+    header.entryCount = get64(p+24);
+    header.legacyCount = get64(p+32);
+    header.salt.assign(p+40, p+40+SALT_SIZE);
+    header.keyCheck.assign(p+56, p+56+Encryption::KEY_CHECK_SIZE);
+    if(std::all_of(header.keyCheck.begin(), header.keyCheck.end(), [](unsigned char b){ return b==0; })){
+      header.keyCheck.clear();
+    }
+    if(header.entryCount>(file.size()-headerSize)/24) corrupted();
+    return true;
+  }
+
+  const Header& getHeader() const{
+    return header;
+  }
+
+  size_t size() const{
+    return header.entryCount;
+  }
+
+  // Decodes the record at index i, touching only its offset slot and bytes
+  Record record(size_t i) const{
+    if(i>=header.entryCount) throw std::out_of_range("Binary vault index out of range");
+    const char* base = file.data();
+    const char* end = base + file.size();
+    uint64_t offset = get64(base + headerSize + i*8);
+    if(offset>file.size()) corrupted();
+    const char* p = base + offset;
+    Record rec;
+    if(version>=2){
+      if(p==end) corrupted();
+      rec.cipher = Encryption::cipherFromByte(static_cast<unsigned char>(*p++));
+    }
+    std::string_view* fields[] = {&rec.id, &rec.service, &rec.username, &rec.ciphertext, &rec.salt, &rec.iv, &rec.timestamp, &rec.notes};
+    for(auto* field : fields){
+      if(end-p<4) corrupted();
+      uint32_t len = get32(p);
+      p += 4;
+      if(static_cast<size_t>(end-p)<len) corrupted();
+      *field = std::string_view(p, len);
+      p += len;
+    }
+    return rec;
+  }
+
+  // Converts a record into the Base64 text form used by PasswordEntry
+  static PasswordEntry toEntry(const Record& rec){
+    PasswordEntry entry;
+    entry.id = rec.id.empty() ? "" : toBase64(rec.id);
+    entry.service = std::string(rec.service);
+    entry.username = std::string(rec.username);
+    entry.encryptedPassword = toBase64(rec.ciphertext);
+    entry.salt = rec.salt.empty() ? "" : toBase64(rec.salt);
+    entry.iv = toBase64(rec.iv);
+    entry.cipher = Encryption::cipherName(rec.cipher);
+    entry.timestamp = std::string(rec.timestamp);
+    entry.notes = std::string(rec.notes);
+    return entry;
+  }
+
+  PasswordEntry entry(size_t i) const{
+    return toEntry(record(i));
+  }
+
+  // Returns indexes of entries whose service matches ignoring case, via binary search of the lookup table
+  std::vector<size_t> findService(const std::string& service) const{
+    std::vector<size_t> found;
+    uint64_t hash = serviceHash(service);
+    size_t lo = 0, hi = header.entryCount;
+    while(lo<hi){
+      size_t mid = lo + (hi-lo)/2;
+      if(get64(lookupSlot(mid))<hash) lo = mid+1;
+      else hi = mid;
+    }
+    std::string folded = foldCase(service);
+    for(size_t i=lo; i<header.entryCount && get64(lookupSlot(i))==hash; i++){
+      size_t index = get64(lookupSlot(i)+8);
+      if(index>=header.entryCount) corrupted();
+      if(foldCase(std::string(record(index).service))==folded) found.push_back(index);  // Skip hash collisions
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+  }
+
+  // Writes entries as a binary vault, atomically replacing path
+  static void write(const std::string& path, const Header& params, const std::vector<PasswordEntry>& entries){
+    if(params.salt.size()!=SALT_SIZE){
+      throw std::runtime_error("Binary vault requires a 16-byte salt");
+    }
+    std::string out;
+    std::string records;
+    std::vector<uint64_t> offsets(entries.size());
+    std::vector<std::pair<uint64_t, uint64_t>> lookup(entries.size());
+    uint64_t legacy = 0;
+    size_t tableEnd = HEADER_SIZE + entries.size()*24;
+    for(size_t i=0; i<entries.size(); i++){
+      const auto& e = entries[i];
+      offsets[i] = tableEnd + records.size();
+      lookup[i] = {serviceHash(e.service), i};
+      if(e.id.empty()) legacy++;
+      records += static_cast<char>(Encryption::cipherFromName(e.cipher));
+      putRawField(records, Base64::decode(e.id));
+      putField(records, e.service);
+      putField(records, e.username);
+      putRawField(records, Base64::decode(e.encryptedPassword));
+      putRawField(records, Base64::decode(e.salt));
+      putRawField(records, Base64::decode(e.iv));
+      putField(records, e.timestamp);
+      putField(records, e.notes);
+    }
+    std::sort(lookup.begin(), lookup.end());
+    out.reserve(tableEnd + records.size());
+    out.append(MAGIC, sizeof(MAGIC));
+    put32(out, FORMAT_VERSION);
+    put32(out, params.kdf.iterations);
+    put64(out, params.generation);
+    put64(out, entries.size());
+    put64(out, legacy);
+    out.append(reinterpret_cast<const char*>(params.salt.data()), SALT_SIZE);
+    if(params.keyCheck.size()==static_cast<size_t>(Encryption::KEY_CHECK_SIZE)){
+      out.append(reinterpret_cast<const char*>(params.keyCheck.data()), params.keyCheck.size());
+    }
+    out.resize(V2_HEADER_SIZE, '\0');
+    put32(out, params.kdf.algorithm);
+    put32(out, params.kdf.memoryKiB);
+    put32(out, params.kdf.parallelism);
+    out.resize(HEADER_SIZE, '\0');
+    for(uint64_t offset : offsets) put64(out, offset);
+    for(const auto& slot : lookup){
+      put64(out, slot.first);
+      put64(out, slot.second);
+    }
+    out += records;
+    DurableFile::writeAtomic(path, out);
+  }
+};
+#endif
@@ -0,0 +1,114 @@
+// bulk_provisioner.h
+#ifndef BULK_PROVISIONER_H
+#define BULK_PROVISIONER_H
+#include<string>
+#include<vector>
+#include<fstream>
+#include<sstream>
+#include<memory>
+#include<chrono>
+#include<stdexcept>
+#include<algorithm>
+#include<cctype>
+#include "password_generator.h"
+#include "password_storage.h"
+#include "parallel.h"
+
+// One credential to create: service,username,length[,charsets[,notes]]
+struct ProvisionSpec{
+  std::string service;
+  std::string username;
+  int length = 16;
+  int charsets = PasswordGenerator::ALL;
+  std::string notes;
+};
+
+// Generates and encrypts many entries across worker threads, then commits them in one write
+class BulkProvisioner{
+public:
+  struct Result{
+    size_t created = 0;
+    double seconds = 0;
+  };
+
+  // Parses charset letters (u=upper, l=lower, d=digits, s=special) or "all"
+  static int parseCharsets(const std::string& text){
+    if(text.empty() || text=="all") return PasswordGenerator::ALL;
+    int charsets = 0;
+    for(char c : text){
+      switch(std::tolower(static_cast<unsigned char>(c))){
+        case 'u': charsets |= PasswordGenerator::UPPERCASE; break;
+        case 'l': charsets |= PasswordGenerator::LOWERCASE; break;
+        case 'd': charsets |= PasswordGenerator::DIGITS; break;
+        case 's': charsets |= PasswordGenerator::SPECIAL; break;
+        default: throw std::invalid_argument("Unknown character set '"+std::string(1, c)+"'");
+      }
+    }
+    return charsets;
+  }
+
+  // Reads specs from a comma-separated file; blank lines and lines starting with # are skipped
+  static std::vector<ProvisionSpec> readSpecs(const std::string& path){
+    std::ifstream file(path);
+    if(!file.is_open()){
+      throw std::runtime_error("Can't open spec file "+path);
+    }
+    std::vector<ProvisionSpec> specs;
+    std::string line;
+    size_t lineNumber = 0;
+    while(std::getline(file, line)){
+      lineNumber++;
+      if(!line.empty() && line.back()=='\r') line.pop_back();
+      if(line.empty() || line[0]=='#') continue;
+      std::vector<std::string> fields;
+      std::stringstream ss(line);
+      std::string field;
+      while(fields.size()<4 && std::getline(ss, field, ',')) fields.push_back(field);
+      ProvisionSpec spec;
+      std::getline(ss, spec.notes);  // Notes take the rest of the line and may contain commas
+      if(fields.size()<3){
+        throw std::runtime_error("Spec line "+std::to_string(lineNumber)+": expected service,username,length[,charsets[,notes]]");
+      }
+      spec.service = fields[0];
+      spec.username = fields[1];
+      try{
+        spec.length = std::stoi(fields[2]);
+        if(fields.size()>3) spec.charsets = parseCharsets(fields[3]);
+      }catch(const std::exception& e){
+        throw std::runtime_error("Spec line "+std::to_string(lineNumber)+": "+e.what());
+      }
+      specs.push_back(spec);
+    }
+    return specs;
+  }
+
+  // Creates an entry for every spec using threads workers (0 = one per core) and commits once
+  static Result provision(PasswordStorage& storage, const std::vector<ProvisionSpec>& specs, unsigned threads=0){
+    auto start = std::chrono::steady_clock::now();
+    storage.unlock();  // Derive the master key once before the workers share it
+    std::vector<PasswordEntry> created(specs.size());
+    if(threads==0) threads = Parallel::defaultThreads();
+    std::vector<std::unique_ptr<PasswordGenerator>> generators;  // Per-worker RNG pool
+    std::vector<std::unique_ptr<PasswordStorage::CryptoWorker>> cryptos;  // Per-worker cipher contexts
+    for(unsigned i=0; i<threads; i++){
+      generators.emplace_back(new PasswordGenerator());
+      cryptos.emplace_back(new PasswordStorage::CryptoWorker());
+    }
+    Parallel::forChunks(specs.size(), threads, 256, [&](unsigned worker, size_t begin, size_t end){
+      PasswordGenerator& generator = *generators[worker];
+      PasswordStorage::CryptoWorker& crypto = *cryptos[worker];
+      for(size_t i=begin; i<end; i++){
+        const auto& spec = specs[i];
+        SecureString password = generator.generate(spec.length, spec.charsets);
+        created[i] = storage.encryptEntry(crypto, spec.service, spec.username, password, spec.notes);
+      }
+    });
+    storage.addEntries(created);
+    storage.commit();
+    Result result;
+    result.created = specs.size();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return result;
+  }
+};
+#endif
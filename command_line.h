@@ -0,0 +1,757 @@
+// command_line.h
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<vector>
+#include<memory>
+#include<chrono>
+#include<functional>
+#include<cstdlib>
+#include<cstdio>
+#include<cerrno>
+#include<stdexcept>
+#include<termios.h>
+#include<unistd.h>
+#include "password_storage.h"
+#include "password_generator.h"
+#include "bulk_provisioner.h"
+#include "parallel.h"
+#include "csv.h"
+#include "vault_agent.h"
+#include "vault_stream.h"
+#include "instrumentation.h"
+#include "secure_memory.h"
+
+// Reads password without displaying on screen for security
+inline SecureString getPasswordInput(const std::string& prompt){
+  std::cout<<prompt;
+  std::cout.flush();
+  termios oldt;
+  tcgetattr(STDIN_FILENO, &oldt);
+  termios newt = oldt;
+  newt.c_lflag &= ~ECHO;  // Disable terminal echo
+  tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+  SecureString password;
+  std::getline(std::cin, password);
+  tcsetattr(STDIN_FILENO, TCSANOW, &oldt);  // Restore terminal echo
+  std::cout<<std::endl;
+  return password;
+}
+
+// Non-interactive subcommands for scripting:
+//   password_manager <command> [options] [arguments]
+//   password_manager --batch [options] < commands
+// In batch mode every stdin line is one command, all run in a single unlocked session.
+class CommandLine{
+private:
+  static const size_t BATCH_COMMIT_EVERY = 1024;  // Mutations between journal commits in batch mode
+
+  // Raised for malformed command lines; reported with exit code 2
+  struct UsageError : std::runtime_error{
+    using std::runtime_error::runtime_error;
+  };
+
+  struct Options{
+    std::string vault = "passwords_secure.json";
+    int passwordFd = -1;         // Read the master password from this descriptor
+    std::string passwordEnv;     // Or from this environment variable
+    bool json = false;           // One JSON object per output record instead of tab-separated fields
+    bool batch = false;
+    int length = 16;
+    int charsets = PasswordGenerator::ALL;
+    size_t count = 0;
+    unsigned threads = 0;
+    std::string notes;
+    SecureString secret;         // Entry password from --secret, which only batch lines may carry
+    std::string secretEnv;
+    bool haveSecret = false;
+    std::string socket;          // Send vault commands to the agent listening here
+    int idle = 900;              // Agent idle seconds before locking, 0 to never lock
+    bool stats = false;          // Print timing statistics to stderr on exit
+    std::string kdf;             // Algorithm for calibrate; Argon2id if available, scrypt otherwise
+    std::string format;          // csv or jsonl for import/export; empty picks by file extension
+    int targetMs = 250;          // Unlock latency calibrate aims for
+    int memory = 0;              // KDF memory cost in KiB, 0 for the default
+    int parallelism = 0;         // KDF lanes, 0 for the default
+    bool apply = false;          // Rekey the vault with the calibrated parameters
+    int minScore = 50;           // audit flags passwords scoring below this
+    std::string sort;            // list order: position (default), service or time
+    size_t offset = 0;           // list skips this many entries
+    bool descending = false;     // list in reverse order
+    int words = 0;               // Generate passphrases of this many words instead of character passwords
+    std::string separator = "-"; // Between passphrase words
+    std::string caps = "lower";  // Passphrase capitalization: lower, title or random
+    std::string extra;           // Add one digit, symbol or either to passphrases
+  };
+
+  Options global;                             // Options from argv, shared by every batch command
+  std::unique_ptr<PasswordStorage> storage;   // Opened on the first command that needs the vault
+  std::unique_ptr<AgentClient> agentClient;   // Connected on the first command routed to the agent
+  PasswordGenerator generator;
+  size_t uncommitted = 0;
+  bool inBatch = false;
+
+  static SecureString quoteJson(std::string_view str){
+    SecureString quoted;
+    VaultStream::appendJsonString(quoted, str);
+    return quoted;
+  }
+
+  // Writes one output record: tab-separated values, or a JSON object when --json is set.
+  // Values that are numbers or booleans are passed with raw=true so JSON keeps their type.
+  // Values may be passwords, so output is built in SecureStrings; each value is copied into one explicitly.
+  struct Field{
+    const char* name;
+    SecureString value;
+    bool raw = false;
+
+    Field(const char* fieldName, std::string_view text, bool isRaw=false) : name(fieldName), value(text), raw(isRaw){}
+  };
+
+  void emit(const std::vector<Field>& fields, std::ostream& out=std::cout) const{
+    SecureString line;
+    if(global.json){
+      line = "{";
+      for(size_t i=0; i<fields.size(); i++){
+        if(i>0) line += ", ";
+        line += quoteJson(fields[i].name)+": "+(fields[i].raw ? fields[i].value : quoteJson(fields[i].value));
+      }
+      line += "}";
+    }else{
+      for(size_t i=0; i<fields.size(); i++){
+        if(i>0) line += '\t';
+        line += fields[i].value;
+      }
+    }
+    out<<line<<'\n';
+  }
+
+  // Reports a failed command; in batch mode on stdout so errors stay in order with results
+  void emitError(const std::string& message) const{
+    if(inBatch){
+      emit({{"error", message}});
+    }else if(global.json){
+      emit({{"error", message}}, std::cerr);
+    }else{
+      std::cerr<<"error: "<<message<<'\n';
+    }
+  }
+
+  static int parseNumber(const std::string& name, const std::string& value){
+    try{
+      size_t used = 0;
+      long n = std::stol(value, &used);
+      if(used!=value.size() || n<0 || n>1000000000) throw std::out_of_range(value);
+      return static_cast<int>(n);
+    }catch(const std::exception&){
+      throw UsageError("Invalid value for "+name+": "+value);
+    }
+  }
+
+  // Splits arguments into options and positional arguments. Vault and password options are only
+  // accepted when allowGlobal is set, i.e. on the real command line rather than a batch line.
+  static std::vector<std::string> parse(const std::vector<std::string>& tokens, Options& opts, bool allowGlobal){
+    std::vector<std::string> positional;
+    for(size_t i=0; i<tokens.size(); i++){
+      const std::string& tok = tokens[i];
+      if(tok.size()<3 || tok.compare(0, 2, "--")!=0){
+        positional.push_back(tok);
+        continue;
+      }
+      if(tok=="--json"){
+        opts.json = true;
+        continue;
+      }
+      if(tok=="--stats"){
+        opts.stats = true;
+        continue;
+      }
+      if(tok=="--apply"){
+        opts.apply = true;
+        continue;
+      }
+      if(tok=="--desc"){
+        opts.descending = true;
+        continue;
+      }
+      if(tok=="--batch"){
+        if(!allowGlobal) throw UsageError("--batch can't be nested");
+        opts.batch = true;
+        continue;
+      }
+      if(i+1>=tokens.size()) throw UsageError("Missing value for "+tok);
+      const std::string& value = tokens[++i];
+      bool sessionOption = tok=="--vault" || tok=="--password-fd" || tok=="--password-env" || tok=="--socket";
+      if(sessionOption && !allowGlobal) throw UsageError(tok+" must be given before --batch");
+      if(tok=="--vault") opts.vault = value;
+      else if(tok=="--password-fd") opts.passwordFd = parseNumber(tok, value);
+      else if(tok=="--password-env") opts.passwordEnv = value;
+      else if(tok=="--socket") opts.socket = value;
+      else if(tok=="--idle") opts.idle = parseNumber(tok, value);
+      else if(tok=="--length") opts.length = parseNumber(tok, value);
+      else if(tok=="--charsets"){
+        try{
+          opts.charsets = BulkProvisioner::parseCharsets(value);
+        }catch(const std::exception& e){
+          throw UsageError(e.what());
+        }
+      }
+      else if(tok=="--count") opts.count = parseNumber(tok, value);
+      else if(tok=="--threads") opts.threads = parseNumber(tok, value);
+      else if(tok=="--notes") opts.notes = value;
+      else if(tok=="--secret"){
+        // Arguments are visible to ps and end up in shell history; batch lines arrive on stdin
+        if(allowGlobal) throw UsageError("--secret is only accepted in --batch input; use --secret-env VAR");
+        opts.secret = value;
+        opts.haveSecret = true;
+      }
+      else if(tok=="--secret-env") opts.secretEnv = value;
+      else if(tok=="--kdf") opts.kdf = value;
+      else if(tok=="--format") opts.format = value;
+      else if(tok=="--target-ms") opts.targetMs = parseNumber(tok, value);
+      else if(tok=="--memory") opts.memory = parseNumber(tok, value);
+      else if(tok=="--parallelism") opts.parallelism = parseNumber(tok, value);
+      else if(tok=="--min-score") opts.minScore = parseNumber(tok, value);
+      else if(tok=="--sort") opts.sort = value;
+      else if(tok=="--words") opts.words = parseNumber(tok, value);
+      else if(tok=="--separator") opts.separator = value;
+      else if(tok=="--caps") opts.caps = value;
+      else if(tok=="--extra") opts.extra = value;
+      else if(tok=="--offset") opts.offset = parseNumber(tok, value);
+      else throw UsageError("Unknown option "+tok);
+    }
+    return positional;
+  }
+
+  // Splits a batch line into words; double quotes group words and backslash escapes the next character
+  static std::vector<std::string> tokenize(const std::string& line){
+    std::vector<std::string> tokens;
+    std::string current;
+    bool inToken = false, quoted = false;
+    for(size_t i=0; i<line.size(); i++){
+      char c = line[i];
+      if(c=='\\' && i+1<line.size()){
+        current += line[++i];
+        inToken = true;
+      }else if(c=='"'){
+        quoted = !quoted;
+        inToken = true;
+      }else if(!quoted && (c==' ' || c=='\t' || c=='\r')){
+        if(inToken) tokens.push_back(current);
+        current.clear();
+        inToken = false;
+      }else{
+        current += c;
+        inToken = true;
+      }
+    }
+    if(quoted) throw UsageError("Unterminated quote");
+    if(inToken) tokens.push_back(current);
+    return tokens;
+  }
+
+  // Reads one line from a file descriptor without buffering past it
+  static SecureString readLineFromFd(int fd){
+    SecureString line;
+    char c;
+    while(true){
+      ssize_t n = ::read(fd, &c, 1);
+      if(n<0 && errno==EINTR) continue;
+      if(n<0) throw std::runtime_error("Can't read master password from descriptor "+std::to_string(fd));
+      if(n==0 || c=='\n') break;
+      line += c;
+    }
+    if(!line.empty() && line.back()=='\r') line.pop_back();
+    return line;
+  }
+
+  SecureString readMasterPassword() const{
+    if(global.passwordFd>=0) return readLineFromFd(global.passwordFd);
+    if(!global.passwordEnv.empty()){
+      const char* value = std::getenv(global.passwordEnv.c_str());
+      if(!value) throw std::runtime_error("Environment variable "+global.passwordEnv+" is not set");
+      return value;
+    }
+    if(!global.batch && isatty(STDIN_FILENO)) return getPasswordInput("Master password: ");
+    throw UsageError("No master password: use --password-fd or --password-env");
+  }
+
+  // Loads and unlocks the vault once per process
+  PasswordStorage& vault(){
+    if(storage) return *storage;
+    SecureString master = readMasterPassword();
+    if(master.length()<8){
+      throw std::runtime_error("Master password must be at least 8 characters");
+    }
+    auto opened = std::make_unique<PasswordStorage>(global.vault, master);
+    opened->load();
+    opened->unlock();
+    if(opened->getLegacyEntryCount()>0){
+      opened->migrateLegacyEntries();
+      opened->save();
+    }
+    storage = std::move(opened);
+    return *storage;
+  }
+
+  // Connection to a running agent when --socket is given, otherwise nullptr
+  AgentClient* agent(){
+    if(global.socket.empty()) return nullptr;
+    if(!agentClient) agentClient = std::make_unique<AgentClient>(global.socket);
+    return agentClient.get();
+  }
+
+  // Commits mutations right away, or every BATCH_COMMIT_EVERY mutations in batch mode
+  void mutated(){
+    uncommitted++;
+    if(!inBatch || uncommitted>=BATCH_COMMIT_EVERY) flush();
+  }
+
+  void flush(){
+    if(storage && uncommitted>0) storage->commit();
+    uncommitted = 0;
+  }
+
+  static void requireArgs(const std::vector<std::string>& args, size_t min, size_t max, const char* usage){
+    if(args.size()-1<min || args.size()-1>max) throw UsageError(std::string("usage: ")+usage);
+  }
+
+  // Entry password from --secret/--secret-env, or a freshly generated one
+  SecureString entrySecret(const Options& opts, bool& generated){
+    generated = false;
+    if(opts.haveSecret) return opts.secret;
+    if(!opts.secretEnv.empty()){
+      const char* value = std::getenv(opts.secretEnv.c_str());
+      if(!value) throw std::runtime_error("Environment variable "+opts.secretEnv+" is not set");
+      return value;
+    }
+    generated = true;
+    if(opts.words) return generator.generatePassphrase(passphraseSpec(opts));
+    return generator.generate(opts.length, opts.charsets);
+  }
+
+  // Passphrase shape from --words, --separator, --caps and --extra
+  static PasswordGenerator::PassphraseSpec passphraseSpec(const Options& opts){
+    PasswordGenerator::PassphraseSpec spec;
+    spec.words = opts.words;
+    spec.separator = opts.separator;
+    if(opts.caps=="title") spec.capitalization = PasswordGenerator::TITLE;
+    else if(opts.caps=="random") spec.capitalization = PasswordGenerator::RANDOM_CASE;
+    else if(opts.caps!="lower") throw UsageError("--caps must be lower, title or random");
+    if(opts.extra=="digit") spec.extra = PasswordGenerator::DIGITS;
+    else if(opts.extra=="symbol") spec.extra = PasswordGenerator::SPECIAL;
+    else if(opts.extra=="either") spec.extra = PasswordGenerator::DIGITS | PasswordGenerator::SPECIAL;
+    else if(!opts.extra.empty()) throw UsageError("--extra must be digit, symbol or either");
+    return spec;
+  }
+
+  // Prints --count N passwords, or passphrases when --words N is given, with their strength. Passphrases
+  // also get their exact entropy in bits, which the strength estimate (built for character passwords) undercounts.
+  void cmdGenerate(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 0, 0, "generate [--length N] [--charsets ulds] [--words N [--separator S] [--caps lower|title|random] [--extra digit|symbol|either]] [--count N]");
+    size_t count = opts.count ? opts.count : 1;
+    if(opts.words){
+      auto spec = passphraseSpec(opts);
+      PasswordBatch batch = generator.generatePassphraseBatch(count, spec);
+      char bits[16];
+      std::snprintf(bits, sizeof(bits), "%.1f", spec.bits());
+      for(size_t i=0; i<batch.count; i++){
+        emit({{"password", SecureString(batch[i])}, {"strength", std::to_string(generator.calculateStrength(batch[i])), true},
+              {"bits", bits, true}});
+      }
+      return;
+    }
+    PasswordBatch batch = generator.generateBatch(count, opts.length, opts.charsets);
+    for(size_t i=0; i<batch.count; i++){
+      emit({{"password", SecureString(batch[i])}, {"strength", std::to_string(generator.calculateStrength(batch[i])), true}});
+    }
+  }
+
+  void cmdAdd(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 2, 2, "add SERVICE USERNAME [--secret-env VAR | --secret PASSWORD (batch only) | --length N --charsets ulds | --words N] [--notes TEXT]");
+    bool generated;
+    SecureString password = entrySecret(opts, generated);
+    if(AgentClient* client = agent()){
+      client->call(AgentProtocol::ADD, {args[1], args[2], password, opts.notes});
+    }else{
+      vault().addEntry(args[1], args[2], password, opts.notes);
+      mutated();
+    }
+    if(generated) emit({{"service", args[1]}, {"username", args[2]}, {"password", password}});
+    else emit({{"service", args[1]}, {"username", args[2]}});
+  }
+
+  void cmdGet(const std::vector<std::string>& args){
+    requireArgs(args, 1, 2, "get SERVICE [USERNAME]");
+    std::string username = args.size()>2 ? args[2] : "";
+    SecureString password;
+    if(AgentClient* client = agent()){
+      auto response = client->call(AgentProtocol::GET, {args[1], username});
+      if(response.fields.empty()) throw std::runtime_error("Malformed agent response");
+      password.swap(response.fields[0]);
+    }else{
+      password = vault().getPassword(args[1], username);
+    }
+    emit({{"password", password}});
+  }
+
+  // Prints one page of entries (--offset N, --count N) in --sort order, optionally only services starting with PREFIX
+  void cmdList(const std::vector<std::string>& args, const Options& opts){
+    const char* usage = "list [PREFIX] [--sort position|service|time] [--desc] [--offset N] [--count N]";
+    requireArgs(args, 0, 1, usage);
+    PasswordStorage::ListQuery query;
+    if(opts.sort=="service") query.order = PasswordStorage::BY_SERVICE;
+    else if(opts.sort=="time") query.order = PasswordStorage::BY_TIMESTAMP;
+    else if(!opts.sort.empty() && opts.sort!="position") throw UsageError(std::string("usage: ")+usage);
+    query.descending = opts.descending;
+    if(args.size()>1) query.servicePrefix = args[1];
+    query.offset = opts.offset;
+    if(opts.count) query.limit = opts.count;
+    if(AgentClient* client = agent()){
+      if(args.size()>1 || !opts.sort.empty() || opts.descending || opts.offset || opts.count){
+        throw UsageError("list through --socket prints every entry; paging and sorting need the vault");
+      }
+      // The agent answers a page at a time; ask from the next offset until every entry has been seen
+      size_t offset = 0, total = 0;
+      do{
+        std::string from = std::to_string(offset);
+        auto response = client->call(AgentProtocol::LIST, {from});
+        const auto& f = response.fields;
+        if(f.empty()) throw std::runtime_error("Malformed agent response");
+        total = std::stoul(std::string(f[0].data(), f[0].size()));
+        size_t received = (f.size()-1)/4;
+        for(size_t i=1; i+3<f.size(); i+=4){
+          emit({{"service", f[i]}, {"username", f[i+1]}, {"timestamp", f[i+2]}, {"notes", f[i+3]}});
+        }
+        if(received==0) break;
+        offset += received;
+      }while(offset<total);
+      return;
+    }
+    vault().listPage(query, [&](const EntryMeta& e){
+      emit({{"service", SecureString(e.service)}, {"username", SecureString(e.username)},
+            {"timestamp", SecureString(e.timestamp)}, {"notes", SecureString(e.notes)}});
+    });
+  }
+
+  // Prints the --count N (default 10) entries most similar to QUERY, from the trigram index alone
+  void cmdSearch(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 1, 1, "search QUERY [--count N]");
+    char score[16];
+    for(const auto& r : vault().search(args[1], opts.count ? opts.count : 10)){
+      std::snprintf(score, sizeof(score), "%.3f", r.score);
+      emit({{"service", r.entry.service}, {"username", r.entry.username}, {"score", score, true},
+            {"match", SearchIndex::fieldName(r.field)}, {"notes", r.entry.notes}});
+    }
+  }
+
+  void cmdDelete(const std::vector<std::string>& args){
+    requireArgs(args, 1, 2, "delete SERVICE [USERNAME]");
+    std::string username = args.size()>2 ? args[2] : "";
+    if(AgentClient* client = agent()){
+      client->call(AgentProtocol::DELETE, {args[1], username});
+    }else if(vault().deleteEntry(args[1], username)){
+      mutated();
+    }else{
+      throw std::runtime_error("Entry not found");
+    }
+    emit({{"deleted", "true", true}});
+  }
+
+  // Format from --format, or from the file extension
+  static VaultStream::Format streamFormat(const std::string& path, const Options& opts){
+    return opts.format.empty() ? VaultStream::formatForPath(path) : VaultStream::formatFromName(opts.format);
+  }
+
+  // Shows running throughput on an interactive stderr
+  static std::function<void(const VaultStream::Result&)> streamProgress(const char* verb){
+    if(!isatty(STDERR_FILENO)) return nullptr;
+    return [verb](const VaultStream::Result& r){
+      std::fprintf(stderr, "\r%s %zu entries, %.0f/s, %.1f MB/s", verb, r.records, r.recordsPerSecond(), r.megabytesPerSecond());
+    };
+  }
+
+  void emitThroughput(const char* verb, const VaultStream::Result& r, std::ostream& out=std::cout) const{
+    if(isatty(STDERR_FILENO)) std::fputc('\n', stderr);  // End the progress line
+    char rate[32], mbps[32];
+    std::snprintf(rate, sizeof(rate), "%.0f", r.recordsPerSecond());
+    std::snprintf(mbps, sizeof(mbps), "%.2f", r.megabytesPerSecond());
+    emit({{verb, std::to_string(r.records), true}, {"bytes", std::to_string(r.bytes), true}, {"seconds", std::to_string(r.seconds), true},
+          {"entries_per_sec", rate, true}, {"mb_per_sec", mbps, true}}, out);
+  }
+
+  // Streams CSV rows of service,username,password[,notes] (a header row is skipped) or JSON Lines objects
+  // from FILE, or stdin for "-", into the vault, committing every VaultStream::BATCH_SIZE entries
+  void cmdImport(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 1, 1, "import FILE|- [--format csv|jsonl] [--threads N]");
+    bool fromStdin = args[1]=="-";
+    if(fromStdin && inBatch) throw UsageError("import - can't read stdin in batch mode");
+    std::ifstream file;
+    if(!fromStdin){
+      file.open(args[1], std::ios::in | std::ios::binary);
+      if(!file.is_open()) throw std::runtime_error("Can't open "+args[1]);
+    }
+    PasswordStorage& store = vault();
+    flush();  // Keep earlier batch mutations ahead of the import in the journal
+    auto result = VaultStream::importFrom(store, fromStdin ? std::cin : file, streamFormat(args[1], opts), opts.threads, streamProgress("Imported"));
+    emitThroughput("imported", result);
+  }
+
+  // Streams every entry with its decrypted password as CSV or JSON Lines to FILE, or stdout for "-"
+  void cmdExport(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 1, 1, "export FILE|- [--format csv|jsonl] [--threads N]");
+    PasswordStorage& store = vault();
+    std::ofstream file;
+    bool toStdout = args[1]=="-";
+    if(!toStdout){
+      file.open(args[1], std::ios::out | std::ios::trunc | std::ios::binary);
+      if(!file.is_open()) throw std::runtime_error("Can't create "+args[1]);
+    }
+    auto result = VaultStream::exportTo(store, toStdout ? std::cout : file, streamFormat(args[1], opts), opts.threads,
+                                        toStdout ? nullptr : streamProgress("Exported"));
+    if(toStdout) emitThroughput("exported", result, std::cerr);  // Keep the export itself clean
+    else emitThroughput("exported", result);
+  }
+
+  // Unlocks the vault and serves it on --socket until interrupted
+  void cmdAgent(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 0, 0, "agent [--socket PATH] [--idle SECONDS]");
+    if(inBatch) throw UsageError("agent can't run in batch mode");
+    std::string path = opts.socket.empty() ? AgentProtocol::defaultSocketPath() : opts.socket;
+    PasswordStorage& store = vault();
+    VaultAgent server(store, path, opts.idle);
+    std::cerr<<"Serving "<<global.vault<<" on "<<path<<'\n';
+    server.run();
+  }
+
+  // Sends UNLOCK, LOCK or STATUS to the agent on --socket
+  void cmdAgentControl(const std::vector<std::string>& args){
+    requireArgs(args, 0, 0, "unlock|lock|status --socket PATH");
+    AgentClient* client = agent();
+    if(!client) throw UsageError(args[0]+" needs --socket");
+    if(args[0]=="unlock"){
+      SecureString master = readMasterPassword();
+      client->call(AgentProtocol::UNLOCK, {master});
+      emit({{"locked", "false", true}});
+    }else if(args[0]=="lock"){
+      client->call(AgentProtocol::LOCK);
+      emit({{"locked", "true", true}});
+    }else{
+      auto response = client->call(AgentProtocol::STATUS);
+      if(response.fields.size()<2) throw std::runtime_error("Malformed agent response");
+      emit({{"locked", response.fields[0]=="locked" ? "true" : "false", true}, {"entries", response.fields[1], true}});
+    }
+  }
+
+  // Prints the instrumentation counters and timers collected so far
+  void cmdStats(const std::vector<std::string>& args){
+    requireArgs(args, 0, 0, "stats");
+    if(global.json) Stats::writeJson(std::cout);
+    else Stats::writeText(std::cout);
+  }
+
+  // Reports weak and reused passwords, one record per flagged entry, then a summary record
+  void cmdAudit(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 0, 0, "audit [--min-score N] [--threads N]");
+    auto report = vault().audit(opts.minScore, opts.threads);
+    char bits[32];
+    for(const auto& f : report.findings){
+      std::snprintf(bits, sizeof(bits), "%.1f", f.bits);
+      bool unreadable = f.score<0;
+      emit({{"service", f.service}, {"username", f.username}, {"score", std::to_string(f.score), true},
+            {"bits", unreadable ? "0" : bits, true}, {"pattern", unreadable ? "unreadable" : StrengthEstimator::patternName(f.weakest)},
+            {"reused", std::to_string(f.reuseCount), true}, {"group", std::to_string(f.reuseGroup), true}});
+    }
+    emit({{"scanned", std::to_string(report.scanned), true}, {"weak", std::to_string(report.weak), true},
+          {"reused", std::to_string(report.reused), true}, {"reuse_groups", std::to_string(report.reuseGroups), true},
+          {"unreadable", std::to_string(report.unreadable), true}, {"seconds", std::to_string(report.seconds), true}});
+  }
+
+  // Picks KDF parameters that take about --target-ms to unlock on this machine; --apply rekeys the vault with them
+  void cmdCalibrate(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 0, 0, "calibrate [--kdf pbkdf2|scrypt|argon2id] [--target-ms MS] [--memory KIB] [--parallelism N] [--apply]");
+    Encryption::Kdf algorithm = Encryption::argon2idAvailable() ? Encryption::ARGON2ID : Encryption::SCRYPT;
+    try{
+      if(!opts.kdf.empty()) algorithm = Encryption::kdfFromName(opts.kdf);
+    }catch(const std::exception& e){
+      throw UsageError(e.what());
+    }
+    if(opts.targetMs<=0) throw UsageError("--target-ms must be positive");
+    auto params = Encryption::calibrate(algorithm, opts.targetMs/1000.0, opts.memory, opts.parallelism);
+    double unlockMs = Encryption::timeKdf(params)*1000;
+    if(opts.apply) vault().changeKdf(params, opts.threads);
+    emit({{"kdf", Encryption::kdfName(params.algorithm)}, {"iterations", std::to_string(params.iterations), true},
+          {"memory_kib", std::to_string(params.memoryKiB), true}, {"parallelism", std::to_string(params.parallelism), true},
+          {"unlock_ms", std::to_string(static_cast<long>(unlockMs)), true}, {"applied", opts.apply ? "true" : "false", true}});
+  }
+
+  // Times fn over ops iterations and reports ns/op
+  template<typename Fn>
+  void measure(const char* name, size_t ops, Fn fn){
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i=0; i<ops; i++) fn(i);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    emit({{"name", name}, {"ops", std::to_string(ops), true},
+          {"ns_per_op", std::to_string(static_cast<long>(seconds*1e9/ops)), true},
+          {"ops_per_sec", std::to_string(static_cast<long>(ops/seconds)), true}});
+  }
+
+  // Quick single-threaded timings of the hot paths on this machine
+  void cmdBench(const std::vector<std::string>& args, const Options& opts){
+    requireArgs(args, 0, 0, "bench [--count N]");
+    size_t count = opts.count ? opts.count : 100000;
+    auto salt = Encryption::randomBytes(Encryption::SALT_SIZE);
+    measure("kdf", 10, [&](size_t){ Encryption::deriveMasterKey("benchmark-password", salt); });
+    SecureString password;
+    measure("generate", count, [&](size_t){ password = generator.generate(opts.length, opts.charsets); });
+    measure("strength", count, [&](size_t){ generator.calculateStrength(password); });
+    PasswordStorage scratch("", "benchmark-password");  // In memory only, never saved
+    scratch.unlock();
+    PasswordStorage::CryptoWorker worker;
+    PasswordEntry entry;
+    measure("seal", count, [&](size_t){ entry = scratch.encryptEntry(worker, "service", "user", password); });
+    measure("open", count, [&](size_t){ scratch.decryptPassword(entry); });
+    auto block = Encryption::randomBytes(1<<20);
+    std::string encoded;
+    measure("base64_encode_1mib", 100, [&](size_t){ encoded = Base64::encode(block); });
+    measure("base64_decode_1mib", 100, [&](size_t){ Base64::decode(encoded); });
+  }
+
+  // Runs one command; returns normally on success and throws on failure
+  void dispatch(const std::vector<std::string>& args, const Options& opts){
+    const std::string& command = args[0];
+    if(command=="generate") cmdGenerate(args, opts);
+    else if(command=="add") cmdAdd(args, opts);
+    else if(command=="get") cmdGet(args);
+    else if(command=="list") cmdList(args, opts);
+    else if(command=="delete") cmdDelete(args);
+    else if(command=="import") cmdImport(args, opts);
+    else if(command=="export") cmdExport(args, opts);
+    else if(command=="bench") cmdBench(args, opts);
+    else if(command=="agent") cmdAgent(args, opts);
+    else if(command=="stats") cmdStats(args);
+    else if(command=="calibrate") cmdCalibrate(args, opts);
+    else if(command=="audit") cmdAudit(args, opts);
+    else if(command=="search") cmdSearch(args, opts);
+    else if(command=="unlock" || command=="lock" || command=="status") cmdAgentControl(args);
+    else throw UsageError("Unknown command "+command);
+  }
+
+  // Runs newline-delimited commands from stdin in one session; returns the number that failed
+  size_t runBatch(){
+    inBatch = true;
+    size_t failed = 0;
+    std::string line;
+    while(std::getline(std::cin, line)){
+      try{
+        auto tokens = tokenize(line);
+        if(tokens.empty() || tokens[0][0]=='#') continue;
+        Options opts = global;
+        auto args = parse(tokens, opts, false);
+        if(args.empty()) throw UsageError("Missing command");
+        dispatch(args, opts);
+      }catch(const std::exception& e){
+        emitError(e.what());
+        failed++;
+      }
+    }
+    flush();
+    return failed;
+  }
+
+  // Parses and runs the command line, returning the exit code
+  int execute(int argc, char* argv[]){
+    std::vector<std::string> tokens(argv+1, argv+argc);
+    try{
+      if(!tokens.empty() && (tokens[0]=="--help" || tokens[0]=="help")){
+        std::cout<<usage();
+        return 0;
+      }
+      auto args = parse(tokens, global, true);
+      if(global.batch){
+        if(!args.empty()) throw UsageError("--batch takes commands on stdin, not arguments");
+        return runBatch()==0 ? 0 : 1;
+      }
+      if(args.empty()) throw UsageError("Missing command");
+      dispatch(args, global);
+      flush();
+      return 0;
+    }catch(const UsageError& e){
+      emitError(e.what());
+      std::cerr<<"Run 'password_manager --help' for usage.\n";
+      return 2;
+    }catch(const std::exception& e){
+      emitError(e.what());
+      return 1;
+    }
+  }
+
+public:
+  static const char* usage(){
+    return
+      "Usage: password_manager [VAULT]                      interactive menu\n"
+      "       password_manager COMMAND [OPTIONS] [ARGS]\n"
+      "       password_manager --batch [OPTIONS] < COMMANDS\n"
+      "\n"
+      "Commands:\n"
+      "  generate                      print new passwords (--length N, --charsets ulds, --count N)\n"
+      "                                or passphrases of --words N from the built-in 7,776-word list with\n"
+      "                                --separator S (default -), --caps lower|title|random and\n"
+      "                                --extra digit|symbol|either; passphrases report their exact bits\n"
+      "  add SERVICE USERNAME          store a generated password or passphrase (--words N), or --secret-env VAR;\n"
+      "                                --notes TEXT. Batch lines may give --secret PASSWORD instead: stdin\n"
+      "                                isn't visible to ps, the command line is, so it's refused there\n"
+      "  get SERVICE [USERNAME]        print a stored password\n"
+      "  list [PREFIX]                 print service, username, timestamp and notes of entries whose service\n"
+      "                                starts with PREFIX (default all); --sort position|service|time, --desc,\n"
+      "                                --offset N and --count N select a page\n"
+      "  search QUERY                  rank entries by similarity of service, username or notes (--count N,\n"
+      "                                default 10); passwords stay encrypted\n"
+      "  delete SERVICE [USERNAME]     remove matching entries\n"
+      "  import FILE|-                 stream entries from CSV service,username,password[,notes] or JSON Lines\n"
+      "                                (--format csv|jsonl, default by extension), committed in batches\n"
+      "  export FILE|-                 stream all entries with passwords as CSV or JSON Lines (--format)\n"
+      "  bench                         time the hot paths on this machine (--count N)\n"
+      "  agent                         keep the vault unlocked and serve it on --socket (--idle SECONDS)\n"
+      "  unlock | lock | status        control the agent on --socket\n"
+      "  stats                         print timing statistics collected so far (useful in --batch)\n"
+      "  audit                         list weak (--min-score N, default 50) and reused passwords per entry,\n"
+      "                                then a summary record; entries are decrypted across --threads N\n"
+      "  calibrate                     pick KDF parameters for a --target-ms unlock time (default 250) with\n"
+      "                                --kdf pbkdf2|scrypt|argon2id (default argon2id if available, else scrypt),\n"
+      "                                --memory KIB, --parallelism N; --apply rekeys the vault with them\n"
+      "\n"
+      "Options:\n"
+      "  --vault PATH                  vault file (default passwords_secure.json)\n"
+      "  --password-fd N               read the master password from descriptor N\n"
+      "  --password-env VAR            read the master password from environment variable VAR\n"
+      "  --socket PATH                 send get/add/list/delete to a running agent instead of opening the vault\n"
+      "  --json                        print one JSON object per record instead of tab-separated fields\n"
+      "  --batch                       run one command per stdin line in a single unlocked session\n"
+      "  --stats                       print timing statistics to stderr on exit (needs -DPASSANOMIX_STATS=ON)\n";
+  }
+
+  // True if argv[1] selects the command-line interface rather than naming a vault file
+  static bool isCommand(const std::string& word){
+    static const char* const commands[] = {"generate", "add", "get", "list", "delete", "import", "export", "bench", "agent", "unlock", "lock", "status", "stats", "calibrate", "audit", "search"};
+    if(word.compare(0, 2, "--")==0) return true;
+    for(const char* command : commands){
+      if(word==command) return true;
+    }
+    return false;
+  }
+
+  // Runs the command line and returns the process exit code: 0 success, 1 failure, 2 usage error
+  int run(int argc, char* argv[]){
+    int status = execute(argc, argv);
+    if(global.stats){
+      if(global.json) Stats::writeJson(std::cerr);
+      else Stats::writeText(std::cerr);
+    }
+    return status;
+  }
+};
+#endif
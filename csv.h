@@ -0,0 +1,84 @@
+// csv.h
+#ifndef CSV_H
+#define CSV_H
+#include<string>
+#include<string_view>
+#include<vector>
+#include<istream>
+#include<stdexcept>
+
+// RFC 4180 style CSV: fields containing commas, quotes or line breaks are quoted, quotes are doubled.
+// The string type is a parameter so records holding passwords can stay in SecureStrings.
+namespace Csv{
+  // Appends field to line, quoting it if needed
+  template<typename String>
+  void appendField(String& line, std::string_view field){
+    if(field.find_first_of(",\"\r\n")==std::string_view::npos && (field.empty() || (field.front()!=' ' && field.back()!=' '))){
+      line += field;
+      return;
+    }
+    line += '"';
+    for(char c : field){
+      if(c=='"') line += '"';
+      line += c;
+    }
+    line += '"';
+  }
+
+  // Joins fields into one CSV record terminated by a newline
+  template<typename String=std::string>
+  String formatRecord(const std::vector<std::string_view>& fields){
+    String line;
+    for(size_t i=0; i<fields.size(); i++){
+      if(i>0) line += ',';
+      appendField(line, fields[i]);
+    }
+    line += '\n';
+    return line;
+  }
+
+  // Reads the next record into fields; quoted fields may span lines. Returns false at end of input.
+  template<typename String>
+  bool readRecord(std::istream& in, std::vector<String>& fields){
+    fields.clear();
+    String line;
+    if(!std::getline(in, line)) return false;
+    String field;
+    bool quoted = false;
+    size_t i = 0;
+    while(true){
+      if(i==line.size()){
+        if(!quoted) break;
+        if(!std::getline(in, line)){
+          throw std::runtime_error("Unterminated quoted CSV field");
+        }
+        field += '\n';
+        i = 0;
+        continue;
+      }
+      char c = line[i++];
+      if(quoted){
+        if(c=='"'){
+          if(i<line.size() && line[i]=='"'){
+            field += '"';
+            i++;
+          }else{
+            quoted = false;
+          }
+        }else if(c!='\r' || i<line.size()){
+          field += c;
+        }
+      }else if(c=='"'){
+        quoted = true;
+      }else if(c==','){
+        fields.push_back(field);
+        field.clear();
+      }else if(c!='\r' || i<line.size()){
+        field += c;
+      }
+    }
+    fields.push_back(field);
+    return true;
+  }
+}
+#endif
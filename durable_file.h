@@ -0,0 +1,150 @@
+// durable_file.h
+#ifndef DURABLE_FILE_H
+#define DURABLE_FILE_H
+#include<string>
+#include<stdexcept>
+#include<cerrno>
+#include<cstring>
+#include<cstdio>
+#include<fcntl.h>
+#include<unistd.h>
+#include<libgen.h>
+#include<sys/file.h>
+#include<sys/stat.h>
+#include "instrumentation.h"
+
+// Crash-safe file primitives used by the vault snapshot and journal
+namespace DurableFile{
+  // Writes the whole buffer to a file descriptor, retrying short writes
+  inline void writeAll(int fd, const char* data, size_t size){
+    while(size>0){
+      ssize_t n = ::write(fd, data, size);
+      if(n<0){
+        if(errno==EINTR) continue;
+        throw std::runtime_error(std::string("Write failed: ")+std::strerror(errno));
+      }
+      data += n;
+      size -= n;
+    }
+  }
+
+  // Flushes the directory holding path so a rename or create survives a crash
+  inline void syncParentDirectory(const std::string& path){
+    std::string copy = path;
+    int fd = ::open(dirname(&copy[0]), O_RDONLY | O_DIRECTORY);
+    if(fd<0) return;  // Best effort, some filesystems don't allow it
+    ::fsync(fd);
+    ::close(fd);
+  }
+
+  // Replaces path with content by writing a temp file, fsyncing it and renaming over the original
+  inline void writeAtomic(const std::string& path, const std::string& content){
+    STATS_TIMER("io.write_atomic");
+    std::string tmp = path+".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if(fd<0){
+      throw std::runtime_error("Can't open file for writing");
+    }
+    try{
+      writeAll(fd, content.data(), content.size());
+      if(::fsync(fd)!=0){
+        throw std::runtime_error(std::string("fsync failed: ")+std::strerror(errno));
+      }
+    }catch(...){
+      ::close(fd);
+      ::unlink(tmp.c_str());
+      throw;
+    }
+    ::close(fd);
+    if(::rename(tmp.c_str(), path.c_str())!=0){
+      ::unlink(tmp.c_str());
+      throw std::runtime_error(std::string("Rename failed: ")+std::strerror(errno));
+    }
+    syncParentDirectory(path);
+  }
+
+  // Appends content to path and fsyncs before returning
+  inline void appendDurable(const std::string& path, const std::string& content){
+    STATS_TIMER("io.append_durable");
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if(fd<0){
+      throw std::runtime_error("Can't open journal for writing");
+    }
+    try{
+      writeAll(fd, content.data(), content.size());
+      if(::fsync(fd)!=0){
+        throw std::runtime_error(std::string("fsync failed: ")+std::strerror(errno));
+      }
+    }catch(...){
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
+  }
+
+  // Removes a file if it exists and makes the removal durable
+  inline void remove(const std::string& path){
+    if(::unlink(path.c_str())==0) syncParentDirectory(path);
+  }
+
+  // Identity and last modification of a file, to notice when another process replaced or appended to it
+  struct Stamp{
+    bool exists = false;
+    dev_t device = 0;
+    ino_t inode = 0;
+    off_t size = 0;
+    long long mtimeNs = 0;
+
+    bool operator==(const Stamp& other) const{
+      return exists==other.exists && device==other.device && inode==other.inode && size==other.size && mtimeNs==other.mtimeNs;
+    }
+
+    bool operator!=(const Stamp& other) const{
+      return !(*this==other);
+    }
+  };
+
+  inline Stamp stamp(const std::string& path){
+    Stamp result;
+    struct stat st;
+    if(::stat(path.c_str(), &st)!=0) return result;
+    result.exists = true;
+    result.device = st.st_dev;
+    result.inode = st.st_ino;
+    result.size = st.st_size;
+    result.mtimeNs = static_cast<long long>(st.st_mtim.tv_sec)*1000000000LL + st.st_mtim.tv_nsec;
+    return result;
+  }
+
+  // Advisory lock held for the object's lifetime: flock on a separate lock file, since the vault itself is
+  // replaced by rename and a lock on it would be left on the old inode. Blocks until granted. Separate
+  // FileLocks on the same path exclude each other even within one process.
+  class FileLock{
+  private:
+    int fd;
+
+  public:
+    FileLock(const std::string& path, bool exclusive){
+      STATS_TIMER("io.file_lock");
+      fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+      if(fd<0){
+        throw std::runtime_error("Can't open lock file "+path+": "+std::strerror(errno));
+      }
+      while(::flock(fd, exclusive ? LOCK_EX : LOCK_SH)!=0){
+        if(errno==EINTR) continue;
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Can't lock "+path+": "+std::strerror(error));
+      }
+    }
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    ~FileLock(){
+      ::flock(fd, LOCK_UN);
+      ::close(fd);
+    }
+  };
+}
+#endif
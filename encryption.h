@@ -2,97 +2,523 @@
 #ifndef ENCRYPTION_H
 #define ENCRYPTION_H
 #include<string>
+#include<string_view>
 #include<vector>
 #include<stdexcept>
 #include<algorithm>
+#include<chrono>
+#include<thread>
+#include<cstdint>
+#include<climits>
 #include<openssl/evp.h> // OpenSSL EVP library for high-level cryptographic functions
 #include<openssl/rand.h> // OpenSSL RAND library for random number generation
+#include<openssl/hmac.h> // OpenSSL HMAC used for HKDF subkey expansion
+#include<openssl/crypto.h> // CRYPTO_memcmp for constant-time comparisons
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include<openssl/kdf.h> // EVP_KDF, fetched at runtime for Argon2id
+#include<openssl/params.h>
+#endif
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L
+#include<openssl/thread.h> // OSSL_set_max_threads, lets Argon2 hash lanes on parallel threads
+#endif
+#include "instrumentation.h"
+#include "secure_memory.h"
 
 class Encryption{
-private:
+public:
   static const int KEY_SIZE = 32;  // 256 bits for AES-256
   static const int IV_SIZE = 16;   // 128 bits for AES block size
   static const int SALT_SIZE = 16;
-  static const int ITERATIONS = 10000;  // PBKDF2 iterations for key derivation
+  static const int ENTRY_ID_SIZE = 16;  // Random per-entry ID used as HKDF info
+  static const int ITERATIONS = 10000;  // PBKDF2 iterations for legacy entries and vaults without recorded KDF parameters
+  static const uint32_t MAX_PBKDF2_ITERATIONS = INT_MAX;  // OpenSSL takes the count as an int
+  static const int KEY_CHECK_SIZE = 8;  // Truncated HMAC stored in the vault header to verify the master key
+  static const int BLOCK_SIZE = 16;     // Ciphertexts are at most this much longer than the plaintext (CBC padding or AEAD tag)
+  static const int TAG_SIZE = 16;       // AEAD authentication tag, appended to the ciphertext
+  static const int AEAD_IV_SIZE = 12;   // 96-bit nonce for GCM and ChaCha20-Poly1305
+  static const int FINGERPRINT_SIZE = 16;  // Truncated HMAC used to find equal secrets without comparing them
 
-  // Derives encryption key from master password using PBKDF2
-  static std::vector<unsigned char> deriveKey(const std::string& password, const std::vector<unsigned char>& salt){
-    std::vector<unsigned char> key(KEY_SIZE);
-    PKCS5_PBKDF2_HMAC(password.c_str(), password.length(), salt.data(), salt.size(), ITERATIONS, EVP_sha256(), KEY_SIZE, key.data());
-    return key;
+  // Cipher suites for vault-key entries; the value is the version byte stored in binary vault records
+  enum Cipher{
+    CBC = 0,                // AES-256-CBC, no integrity check (entries written before AEAD support)
+    GCM = 1,                // AES-256-GCM
+    CHACHA20_POLY1305 = 2   // ChaCha20-Poly1305, faster than GCM on CPUs without AES instructions
+  };
+  static const int CIPHER_COUNT = 3;
+
+  static bool isAead(Cipher cipher){
+    return cipher!=CBC;
   }
 
-public:
-  struct EncryptedData{
-    std::vector<unsigned char> salt;
-    std::vector<unsigned char> iv;
-    std::vector<unsigned char> ciphertext;
+  static int ivSize(Cipher cipher){
+    return isAead(cipher) ? AEAD_IV_SIZE : IV_SIZE;
+  }
+
+  // Name stored in the entry's "cipher" field; CBC entries leave the field empty
+  static const char* cipherName(Cipher cipher){
+    switch(cipher){
+      case GCM: return "aes-256-gcm";
+      case CHACHA20_POLY1305: return "chacha20-poly1305";
+      default: return "";
+    }
+  }
+
+  static Cipher cipherFromName(const std::string& name){
+    if(name.empty() || name=="aes-256-cbc") return CBC;
+    if(name=="aes-256-gcm") return GCM;
+    if(name=="chacha20-poly1305") return CHACHA20_POLY1305;
+    throw std::runtime_error("Unsupported cipher "+name);
+  }
+
+  static Cipher cipherFromByte(unsigned value){
+    if(value>=CIPHER_COUNT){
+      throw std::runtime_error("Unsupported cipher version "+std::to_string(value));
+    }
+    return static_cast<Cipher>(value);
+  }
+
+  // Cipher for newly written entries: AES-GCM where the CPU has AES instructions, ChaCha20-Poly1305 otherwise
+  static Cipher preferredCipher(){
+#if defined(__x86_64__) || defined(__i386__)
+    static const Cipher cipher = __builtin_cpu_supports("aes") ? GCM : CHACHA20_POLY1305;
+    return cipher;
+#else
+    return GCM;
+#endif
+  }
+
+  // Password hashing functions for the vault master key; the value is stored in binary vault headers
+  enum Kdf{
+    PBKDF2_SHA256 = 0,  // PBKDF2-HMAC-SHA256 (every vault written before KDF parameters were recorded)
+    SCRYPT = 1,         // scrypt with r = 8
+    ARGON2ID = 2        // Argon2id, memory-hard; lanes are hashed on parallel threads
   };
+  static const int KDF_COUNT = 3;
+  static const uint32_t SCRYPT_R = 8;
 
-  // Encrypts plaintext using AES-256-CBC
-  static EncryptedData encrypt(const std::string& plaintext, const std::string& password){
-    EncryptedData result;
-    result.salt.resize(SALT_SIZE);
-    result.iv.resize(IV_SIZE);
-    // Generate random salt and IV for this encryption
-    if(RAND_bytes(result.salt.data(), SALT_SIZE)!=1 || RAND_bytes(result.iv.data(), IV_SIZE)!=1){
-      throw std::runtime_error("Failed to generate random bytes");
+  // Master key derivation parameters, recorded in the vault header
+  struct KdfParams{
+    Kdf algorithm = PBKDF2_SHA256;
+    uint32_t iterations = ITERATIONS;  // PBKDF2 rounds, scrypt cost N (a power of two) or Argon2 passes
+    uint32_t memoryKiB = 0;            // Argon2 memory cost; informational for scrypt (128 * r * N bytes)
+    uint32_t parallelism = 1;          // scrypt p or Argon2 lanes
+  };
+
+  static const char* kdfName(Kdf kdf){
+    switch(kdf){
+      case SCRYPT: return "scrypt";
+      case ARGON2ID: return "argon2id";
+      default: return "pbkdf2-sha256";
+    }
+  }
+
+  static Kdf kdfFromName(const std::string& name){
+    if(name=="pbkdf2-sha256" || name=="pbkdf2") return PBKDF2_SHA256;
+    if(name=="scrypt") return SCRYPT;
+    if(name=="argon2id") return ARGON2ID;
+    throw std::runtime_error("Unsupported KDF "+name);
+  }
+
+  static Kdf kdfFromByte(unsigned value){
+    if(value>=KDF_COUNT){
+      throw std::runtime_error("Unsupported KDF version "+std::to_string(value));
+    }
+    return static_cast<Kdf>(value);
+  }
+
+  // True if the linked OpenSSL provides Argon2id (3.2 and newer)
+  static bool argon2idAvailable(){
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    static const bool available = [](){
+      EVP_KDF* kdf = EVP_KDF_fetch(nullptr, "ARGON2ID", nullptr);
+      EVP_KDF_free(kdf);
+      return kdf!=nullptr;
+    }();
+    return available;
+#else
+    return false;
+#endif
+  }
+
+  // Rejects parameters a vault header could carry but no derivation should run with
+  static void validateKdf(const KdfParams& params){
+    bool valid = params.iterations>0 && params.parallelism>0;
+    if(params.algorithm==PBKDF2_SHA256){
+      valid = valid && params.iterations<=MAX_PBKDF2_ITERATIONS;
+    }else if(params.algorithm==SCRYPT){
+      valid = valid && params.iterations>1 && (params.iterations & (params.iterations-1))==0;
+    }else if(params.algorithm==ARGON2ID){
+      valid = valid && params.parallelism<=0xFFFFFF && params.memoryKiB>=8*params.parallelism;
+    }
+    if(!valid){
+      throw std::runtime_error(std::string("Invalid ")+kdfName(params.algorithm)+" parameters");
+    }
+  }
+
+  // Keeps cipher contexts initialized across calls so bulk loops don't allocate per entry; a batch of
+  // entries goes through the same context and only re-keys it. One context per cipher, created on first use.
+  // Not thread-safe; give each worker thread its own session.
+  class Session{
+  private:
+    EVP_CIPHER_CTX* encCtx[CIPHER_COUNT] = {};
+    EVP_CIPHER_CTX* decCtx[CIPHER_COUNT] = {};
+
+    static const EVP_CIPHER* evpCipher(Cipher cipher){
+      switch(cipher){
+        case GCM: return EVP_aes_256_gcm();
+        case CHACHA20_POLY1305: return EVP_chacha20_poly1305();
+        default: return EVP_aes_256_cbc();
+      }
+    }
+
+    static EVP_CIPHER_CTX* context(EVP_CIPHER_CTX** contexts, Cipher cipher, bool encrypting){
+      EVP_CIPHER_CTX*& ctx = contexts[cipherFromByte(cipher)];
+      if(ctx) return ctx;
+      ctx = EVP_CIPHER_CTX_new();
+      if(!ctx || EVP_CipherInit_ex(ctx, evpCipher(cipher), nullptr, nullptr, nullptr, encrypting ? 1 : 0)!=1){
+        throw std::runtime_error("Failed to create cipher context");
+      }
+      return ctx;
+    }
+
+  public:
+    Session() = default;
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    ~Session(){
+      for(int i=0; i<CIPHER_COUNT; i++){
+        EVP_CIPHER_CTX_free(encCtx[i]);  // Frees and cleanses the expanded key schedule
+        EVP_CIPHER_CTX_free(decCtx[i]);
+      }
     }
-    auto key = deriveKey(password, result.salt);
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if(!ctx) throw std::runtime_error("Failed to create cipher context");
-    try{
-      if(EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, key.data(), result.iv.data())!=1){
+
+    // Encrypts len bytes into out, which must hold len+BLOCK_SIZE bytes; returns the ciphertext length.
+    // AEAD ciphers authenticate aad as well and append the tag. iv must be ivSize(cipher) bytes.
+    size_t encryptInto(Cipher cipher, const unsigned char* key, const unsigned char* iv, const unsigned char* aad, size_t aadLen,
+                       const unsigned char* in, size_t len, unsigned char* out, size_t capacity){
+      STATS_TIMER("cipher.encrypt");
+      if(capacity<len+BLOCK_SIZE){
+        throw std::length_error("Ciphertext buffer too small");
+      }
+      EVP_CIPHER_CTX* ctx = context(encCtx, cipher, true);
+      int outLen=0, finalLen=0;
+      if(EVP_EncryptInit_ex(ctx, nullptr, nullptr, key, iv)!=1){
         throw std::runtime_error("Encryption initialization failed");
       }
-      result.ciphertext.resize(plaintext.length() + EVP_CIPHER_block_size(EVP_aes_256_cbc()));
-      int len=0, ciphertext_len=0;
-      if(EVP_EncryptUpdate(ctx, result.ciphertext.data(), &len, reinterpret_cast<const unsigned char*>(plaintext.c_str()), plaintext.length())!=1){
+      if(isAead(cipher) && aadLen>0 && EVP_EncryptUpdate(ctx, nullptr, &outLen, aad, aadLen)!=1){
         throw std::runtime_error("Encryption failed");
       }
-      ciphertext_len = len;
-      if(EVP_EncryptFinal_ex(ctx, result.ciphertext.data()+len, &len)!=1){
+      if(EVP_EncryptUpdate(ctx, out, &outLen, in, len)!=1){
+        throw std::runtime_error("Encryption failed");
+      }
+      if(EVP_EncryptFinal_ex(ctx, out+outLen, &finalLen)!=1){
         throw std::runtime_error("Encryption finalization failed");
       }
-      ciphertext_len += len;
-      result.ciphertext.resize(ciphertext_len);
-      EVP_CIPHER_CTX_free(ctx);
-      std::fill(key.begin(), key.end(), 0);  // Zero out key from memory for security
-    }catch(...){
-      EVP_CIPHER_CTX_free(ctx);
-      std::fill(key.begin(), key.end(), 0);
-      throw;
+      size_t total = outLen+finalLen;
+      if(isAead(cipher)){
+        if(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, TAG_SIZE, out+total)!=1){
+          throw std::runtime_error("Encryption finalization failed");
+        }
+        total += TAG_SIZE;
+      }
+      return total;
     }
-    return result;
-  }
 
-  // Decrypts ciphertext using AES-256-CBC
-  static std::string decrypt(const EncryptedData& data, const std::string& password){
-    auto key = deriveKey(password, data.salt);
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if(!ctx) throw std::runtime_error("Failed to create cipher context");
-    try{
-      if(EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, key.data(), data.iv.data())!=1){
+    // Decrypts len bytes into out, which must hold len+BLOCK_SIZE bytes; returns the plaintext length.
+    // For AEAD ciphers the trailing tag is checked against the ciphertext and aad.
+    size_t decryptInto(Cipher cipher, const unsigned char* key, const unsigned char* iv, const unsigned char* aad, size_t aadLen,
+                       const unsigned char* in, size_t len, unsigned char* out, size_t capacity){
+      STATS_TIMER("cipher.decrypt");
+      if(capacity<len+BLOCK_SIZE){
+        throw std::length_error("Plaintext buffer too small");
+      }
+      if(isAead(cipher)){
+        if(len<static_cast<size_t>(TAG_SIZE)){
+          throw std::runtime_error("Wrong password or corrupted data");
+        }
+        len -= TAG_SIZE;
+      }
+      EVP_CIPHER_CTX* ctx = context(decCtx, cipher, false);
+      int outLen=0, finalLen=0;
+      if(EVP_DecryptInit_ex(ctx, nullptr, nullptr, key, iv)!=1){
         throw std::runtime_error("Decryption initialization failed");
       }
-      std::vector<unsigned char> plaintext(data.ciphertext.size() + EVP_CIPHER_block_size(EVP_aes_256_cbc()));
-      int len=0, plaintext_len=0;
-      if(EVP_DecryptUpdate(ctx, plaintext.data(), &len, data.ciphertext.data(), data.ciphertext.size())!=1){
+      if(isAead(cipher)){
+        if(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, TAG_SIZE, const_cast<unsigned char*>(in+len))!=1 ||
+           (aadLen>0 && EVP_DecryptUpdate(ctx, nullptr, &outLen, aad, aadLen)!=1)){
+          throw std::runtime_error("Decryption failed");
+        }
+      }
+      if(EVP_DecryptUpdate(ctx, out, &outLen, in, len)!=1){
         throw std::runtime_error("Decryption failed");
       }
-      plaintext_len = len;
-      if(EVP_DecryptFinal_ex(ctx, plaintext.data()+len, &len)!=1){
+      if(EVP_DecryptFinal_ex(ctx, out+outLen, &finalLen)!=1){
         throw std::runtime_error("Wrong password or corrupted data");
       }
-      plaintext_len += len;
-      EVP_CIPHER_CTX_free(ctx);
-      std::fill(key.begin(), key.end(), 0);  // Zero out key from memory
-      return std::string(reinterpret_cast<char*>(plaintext.data()), plaintext_len);
-    }catch(...){
-      EVP_CIPHER_CTX_free(ctx);
-      std::fill(key.begin(), key.end(), 0);
-      throw;
+      return outLen+finalLen;
+    }
+  };
+
+private:
+  // Derives encryption key from master password using PBKDF2
+  static SecureBytes deriveKey(std::string_view password, const std::vector<unsigned char>& salt, uint32_t iterations=ITERATIONS){
+    STATS_TIMER("kdf.pbkdf2");
+    if(iterations==0 || iterations>MAX_PBKDF2_ITERATIONS){
+      throw std::runtime_error("Invalid pbkdf2 parameters");
+    }
+    SecureBytes key(KEY_SIZE);
+    if(PKCS5_PBKDF2_HMAC(password.data(), password.length(), salt.data(), salt.size(), static_cast<int>(iterations), EVP_sha256(), KEY_SIZE, key.data())!=1){
+      throw std::runtime_error("Key derivation failed");
+    }
+    return key;
+  }
+
+  // Derives the key with scrypt; iterations is N, parallelism is p
+  static SecureBytes deriveScrypt(std::string_view password, const std::vector<unsigned char>& salt, const KdfParams& params){
+    STATS_TIMER("kdf.scrypt");
+    SecureBytes key(KEY_SIZE);
+    uint64_t maxmem = 128ULL*SCRYPT_R*(static_cast<uint64_t>(params.iterations)+params.parallelism+2);
+    if(EVP_PBE_scrypt(password.data(), password.length(), salt.data(), salt.size(), params.iterations, SCRYPT_R,
+                      params.parallelism, maxmem, key.data(), KEY_SIZE)!=1){
+      throw std::runtime_error("Key derivation failed");
+    }
+    return key;
+  }
+
+  // Threads OpenSSL may run Argon2 lanes on: one per core, granted to the library once per process. Each
+  // derivation asks for up to this many through its own "threads" parameter instead of resetting the limit.
+  static uint32_t argon2ThreadLimit(){
+    static const uint32_t limit = [](){
+      uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L
+      OSSL_set_max_threads(nullptr, cores);
+#endif
+      return cores;
+    }();
+    return limit;
+  }
+
+  // Derives the key with Argon2id through the EVP_KDF interface, which only providers from OpenSSL 3.2 on
+  // implement; lanes run on up to parallelism threads when the library allows it
+  static SecureBytes deriveArgon2id(std::string_view password, const std::vector<unsigned char>& salt, const KdfParams& params){
+    STATS_TIMER("kdf.argon2id");
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+    throw std::runtime_error("Argon2id is not available in this OpenSSL build (requires OpenSSL 3.2 or newer)");
+#else
+    EVP_KDF* kdf = EVP_KDF_fetch(nullptr, "ARGON2ID", nullptr);
+    if(!kdf){
+      throw std::runtime_error("Argon2id is not available in this OpenSSL build (requires OpenSSL 3.2 or newer)");
+    }
+    EVP_KDF_CTX* ctx = EVP_KDF_CTX_new(kdf);
+    EVP_KDF_free(kdf);
+    if(!ctx){
+      throw std::runtime_error("Key derivation failed");
+    }
+    uint32_t iterations = params.iterations, lanes = params.parallelism, memory = params.memoryKiB;
+    uint32_t threads = std::min(params.parallelism, argon2ThreadLimit());
+    OSSL_PARAM ossl[] = {
+      OSSL_PARAM_construct_octet_string("pass", const_cast<char*>(password.data()), password.size()),
+      OSSL_PARAM_construct_octet_string("salt", const_cast<unsigned char*>(salt.data()), salt.size()),
+      OSSL_PARAM_construct_uint32("iter", &iterations),
+      OSSL_PARAM_construct_uint32("lanes", &lanes),
+      OSSL_PARAM_construct_uint32("threads", &threads),
+      OSSL_PARAM_construct_uint32("memcost", &memory),
+      OSSL_PARAM_construct_end()
+    };
+    SecureBytes key(KEY_SIZE);
+    int ok = EVP_KDF_derive(ctx, key.data(), KEY_SIZE, ossl);
+    EVP_KDF_CTX_free(ctx);
+    if(ok!=1){
+      throw std::runtime_error("Key derivation failed");
+    }
+    return key;
+#endif
+  }
+
+  // Runs AES-256-CBC encryption of plaintext under an already derived key
+  static std::vector<unsigned char> encryptCBC(std::string_view plaintext, const SecureBytes& key, const std::vector<unsigned char>& iv){
+    Session session;
+    std::vector<unsigned char> ciphertext(plaintext.length() + BLOCK_SIZE);
+    ciphertext.resize(session.encryptInto(CBC, key.data(), iv.data(), nullptr, 0, reinterpret_cast<const unsigned char*>(plaintext.data()), plaintext.length(), ciphertext.data(), ciphertext.size()));
+    return ciphertext;
+  }
+
+  // Runs AES-256-CBC decryption of ciphertext under an already derived key
+  static SecureString decryptCBC(const std::vector<unsigned char>& ciphertext, const SecureBytes& key, const std::vector<unsigned char>& iv){
+    Session session;
+    SecureBytes plaintext(ciphertext.size() + BLOCK_SIZE);  // Zeroed by the allocator when freed
+    size_t len = session.decryptInto(CBC, key.data(), iv.data(), nullptr, 0, ciphertext.data(), ciphertext.size(), plaintext.data(), plaintext.size());
+    return SecureString(reinterpret_cast<char*>(plaintext.data()), len);
+  }
+
+public:
+  struct EncryptedData{
+    std::vector<unsigned char> salt;
+    std::vector<unsigned char> iv;
+    std::vector<unsigned char> ciphertext;
+  };
+
+  // Generates cryptographically secure random bytes
+  static std::vector<unsigned char> randomBytes(size_t count){
+    std::vector<unsigned char> bytes(count);
+    randomInto(bytes.data(), count);
+    return bytes;
+  }
+
+  // Derives the vault master key from the master password; run once at unlock
+  static SecureBytes deriveMasterKey(std::string_view password, const std::vector<unsigned char>& salt, uint32_t iterations=ITERATIONS){
+    return deriveKey(password, salt, iterations);
+  }
+
+  static SecureBytes deriveMasterKey(std::string_view password, const std::vector<unsigned char>& salt, const KdfParams& params){
+    validateKdf(params);
+    switch(params.algorithm){
+      case SCRYPT: return deriveScrypt(password, salt, params);
+      case ARGON2ID: return deriveArgon2id(password, salt, params);
+      default: return deriveKey(password, salt, params.iterations);
+    }
+  }
+
+  // Seconds one master key derivation with params takes on this machine
+  static double timeKdf(const KdfParams& params){
+    auto salt = randomBytes(SALT_SIZE);
+    auto start = std::chrono::steady_clock::now();
+    deriveMasterKey("calibration", salt, params);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-start;
+    return elapsed.count();
+  }
+
+  // Picks parameters for algorithm so that unlocking takes about targetSeconds here. PBKDF2 scales its
+  // iterations (never below ITERATIONS); scrypt doubles N from 16 MiB; Argon2id keeps memoryKiB (default
+  // 64 MiB, halved if a single pass is already too slow) and parallelism lanes (default: cores, up to 4)
+  // and scales its passes. memoryKiB and parallelism of 0 mean the defaults.
+  static KdfParams calibrate(Kdf algorithm, double targetSeconds, uint32_t memoryKiB=0, uint32_t parallelism=0){
+    KdfParams params;
+    params.algorithm = algorithm;
+    if(algorithm==PBKDF2_SHA256){
+      params.iterations = ITERATIONS;
+      double elapsed = timeKdf(params);
+      while(elapsed<0.02){  // Probe long enough for a stable measurement
+        params.iterations *= 4;
+        elapsed = timeKdf(params);
+      }
+      double scaled = params.iterations*targetSeconds/elapsed;
+      params.iterations = static_cast<uint32_t>(std::min(std::max(scaled, static_cast<double>(ITERATIONS)), static_cast<double>(MAX_PBKDF2_ITERATIONS)));
+    }else if(algorithm==SCRYPT){
+      params.iterations = 1u<<14;
+      params.parallelism = parallelism ? parallelism : 1;
+      double elapsed = timeKdf(params);
+      while(elapsed*2<=targetSeconds && params.iterations<(1u<<30)){
+        params.iterations <<= 1;
+        elapsed *= 2;
+      }
+      params.memoryKiB = static_cast<uint32_t>(128ULL*SCRYPT_R*params.iterations/1024);
+    }else{
+      unsigned cores = std::thread::hardware_concurrency();
+      params.parallelism = parallelism ? parallelism : std::min(std::max(cores, 1u), 4u);
+      params.memoryKiB = memoryKiB ? memoryKiB : 64*1024;
+      params.iterations = 1;
+      double elapsed = timeKdf(params);
+      while(elapsed>targetSeconds && params.memoryKiB/2>=8*1024 && params.memoryKiB/2>=8*params.parallelism){
+        params.memoryKiB /= 2;
+        elapsed = timeKdf(params);
+      }
+      params.iterations = std::max(1u, static_cast<uint32_t>(targetSeconds/elapsed));
+    }
+    return params;
+  }
+
+  // Fills out with cryptographically secure random bytes
+  static void randomInto(unsigned char* out, size_t count){
+    if(RAND_bytes(out, count)!=1){
+      throw std::runtime_error("Failed to generate random bytes");
+    }
+  }
+
+  // Expands a per-entry subkey from the master key with HKDF-SHA256 (expand step) into out[KEY_SIZE].
+  // A single HMAC block covers the 32-byte key, so this is one HMAC call per entry.
+  static void deriveEntryKeyInto(const unsigned char* masterKey, size_t masterKeyLen, const unsigned char* entryId, size_t entryIdLen, unsigned char* out){
+    STATS_TIMER("kdf.subkey");
+    static const char label[] = "passanomix-entry-key";
+    static const size_t labelLen = sizeof(label)-1;
+    unsigned char info[labelLen + 64 + 1];
+    if(entryIdLen>64){
+      throw std::invalid_argument("Entry ID too long");
+    }
+    std::copy(label, label+labelLen, info);
+    std::copy(entryId, entryId+entryIdLen, info+labelLen);
+    info[labelLen+entryIdLen] = 0x01;  // HKDF block counter T(1)
+    unsigned int len = 0;
+    if(!HMAC(EVP_sha256(), masterKey, masterKeyLen, info, labelLen+entryIdLen+1, out, &len) || len!=KEY_SIZE){
+      throw std::runtime_error("Subkey derivation failed");
+    }
+  }
+
+  static SecureBytes deriveEntryKey(const SecureBytes& masterKey, const std::vector<unsigned char>& entryId){
+    SecureBytes key(KEY_SIZE);
+    deriveEntryKeyInto(masterKey.data(), masterKey.size(), entryId.data(), entryId.size(), key.data());
+    return key;
+  }
+
+  // Computes the key-check value for a vault master key, a truncated HMAC under its own label so it
+  // reveals nothing about entry subkeys
+  static std::vector<unsigned char> keyCheck(const SecureBytes& masterKey){
+    static const char label[] = "passanomix-key-check";
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    unsigned int len = 0;
+    if(!HMAC(EVP_sha256(), masterKey.data(), masterKey.size(), reinterpret_cast<const unsigned char*>(label), sizeof(label)-1, mac, &len)){
+      throw std::runtime_error("Key check derivation failed");
     }
+    std::vector<unsigned char> check(mac, mac+KEY_CHECK_SIZE);
+    OPENSSL_cleanse(mac, sizeof(mac));
+    return check;
+  }
+
+  // Computes a keyed fingerprint of a secret into out[FINGERPRINT_SIZE]; equal secrets under the same key
+  // give equal fingerprints, and without the key they reveal nothing about the secret
+  static void fingerprintInto(const SecureBytes& key, const void* data, size_t len, unsigned char* out){
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    unsigned int macLen = 0;
+    if(!HMAC(EVP_sha256(), key.data(), key.size(), static_cast<const unsigned char*>(data), len, mac, &macLen)){
+      throw std::runtime_error("Fingerprint derivation failed");
+    }
+    std::copy(mac, mac+FINGERPRINT_SIZE, out);
+    OPENSSL_cleanse(mac, sizeof(mac));
+  }
+
+  // Compares key-check values in constant time
+  static bool keyCheckMatches(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b){
+    return a.size()==b.size() && CRYPTO_memcmp(a.data(), b.data(), a.size())==0;
+  }
+
+  // Encrypts plaintext using AES-256-CBC with a per-entry salt and PBKDF2 (legacy format)
+  static EncryptedData encrypt(std::string_view plaintext, std::string_view password){
+    EncryptedData result;
+    result.salt = randomBytes(SALT_SIZE);  // Generate random salt and IV for this encryption
+    result.iv = randomBytes(IV_SIZE);
+    auto key = deriveKey(password, result.salt);  // Zeroed by the allocator when freed
+    result.ciphertext = encryptCBC(plaintext, key, result.iv);
+    return result;
+  }
+
+  // Decrypts ciphertext using AES-256-CBC with a per-entry salt and PBKDF2 (legacy format)
+  static SecureString decrypt(const EncryptedData& data, std::string_view password){
+    auto key = deriveKey(password, data.salt);
+    return decryptCBC(data.ciphertext, key, data.iv);
+  }
+
+  // Encrypts plaintext using AES-256-CBC under an already derived key; salt is left empty
+  static EncryptedData encryptWithKey(std::string_view plaintext, const SecureBytes& key){
+    EncryptedData result;
+    result.iv = randomBytes(IV_SIZE);
+    result.ciphertext = encryptCBC(plaintext, key, result.iv);
+    return result;
+  }
+
+  // Decrypts ciphertext using AES-256-CBC under an already derived key
+  static SecureString decryptWithKey(const EncryptedData& data, const SecureBytes& key){
+    return decryptCBC(data.ciphertext, key, data.iv);
   }
 };
 #endif
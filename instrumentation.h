@@ -0,0 +1,169 @@
+// instrumentation.h
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+#include<string>
+#include<deque>
+#include<mutex>
+#include<atomic>
+#include<chrono>
+#include<cstdint>
+#include<cstring>
+#include<ostream>
+#include<iomanip>
+#include<algorithm>
+
+// Scoped timers and counters for the hot paths, compiled in only with -DPASSANOMIX_STATS
+// (CMake option PASSANOMIX_STATS). Without it STATS_TIMER and STATS_COUNT expand to nothing.
+//
+//   STATS_TIMER("kdf.pbkdf2");          times the rest of the enclosing scope
+//   STATS_COUNT("json.entries", n);     adds n to a counter
+namespace Stats{
+  const int BUCKETS = 40;  // Latency histogram bucket i holds durations in [2^i, 2^(i+1)) ns
+
+  struct Metric{
+    const char* name;
+    bool timed;
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> maxNs{0};
+    std::atomic<uint64_t> buckets[BUCKETS] = {};
+
+    Metric(const char* metricName, bool isTimed) : name(metricName), timed(isTimed){}
+
+    void add(uint64_t n){
+      count.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void record(uint64_t ns){
+      count.fetch_add(1, std::memory_order_relaxed);
+      totalNs.fetch_add(ns, std::memory_order_relaxed);
+      uint64_t seen = maxNs.load(std::memory_order_relaxed);
+      while(ns>seen && !maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)){}
+      int bucket = ns ? 63-__builtin_clzll(ns) : 0;
+      buckets[bucket<BUCKETS ? bucket : BUCKETS-1].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Upper bound of the histogram bucket holding quantile q of the recorded durations, capped at the maximum
+    uint64_t quantileNs(double q) const{
+      uint64_t total = 0;
+      for(const auto& b : buckets) total += b.load(std::memory_order_relaxed);
+      if(total==0) return 0;
+      uint64_t rank = static_cast<uint64_t>(q*(total-1)), seen = 0;
+      for(int i=0; i<BUCKETS; i++){
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if(seen>rank) return std::min<uint64_t>((2ULL<<i)-1, maxNs.load(std::memory_order_relaxed));
+      }
+      return maxNs.load(std::memory_order_relaxed);
+    }
+  };
+
+  // All metrics in registration order; addresses stay stable so call sites can cache them
+  class Registry{
+  private:
+    std::mutex mutex;
+    std::deque<Metric> metrics;
+
+  public:
+    Metric& get(const char* name, bool timed){
+      std::lock_guard<std::mutex> lock(mutex);
+      for(auto& m : metrics){
+        if(std::strcmp(m.name, name)==0) return m;
+      }
+      metrics.emplace_back(name, timed);
+      return metrics.back();
+    }
+
+    template<typename Fn>
+    void forEach(Fn fn){
+      std::lock_guard<std::mutex> lock(mutex);
+      for(auto& m : metrics) fn(m);
+    }
+  };
+
+  inline Registry& registry(){
+    static Registry instance;
+    return instance;
+  }
+
+  class ScopedTimer{
+  private:
+    Metric& metric;
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    explicit ScopedTimer(Metric& m) : metric(m), start(std::chrono::steady_clock::now()){}
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer(){
+      metric.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count());
+    }
+  };
+
+  inline constexpr bool enabled(){
+#ifdef PASSANOMIX_STATS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Writes one line per metric: count, and for timers total, mean, p50, p99 and max
+  inline void writeText(std::ostream& out){
+    if(!enabled()){
+      out<<"Statistics are not compiled in; rebuild with -DPASSANOMIX_STATS=ON\n";
+      return;
+    }
+    registry().forEach([&](const Metric& m){
+      out<<std::left<<std::setw(24)<<m.name<<std::right<<" count="<<m.count.load();
+      uint64_t count = m.count.load();
+      if(m.timed && count>0){
+        out<<std::fixed<<std::setprecision(3)
+           <<" total="<<m.totalNs.load()/1e6<<"ms"
+           <<" mean="<<m.totalNs.load()/1e3/count<<"us"
+           <<" p50<="<<m.quantileNs(0.5)/1e3<<"us"
+           <<" p99<="<<m.quantileNs(0.99)/1e3<<"us"
+           <<" max="<<m.maxNs.load()/1e3<<"us";
+      }
+      out<<'\n';
+    });
+  }
+
+  // Writes all metrics as one JSON object keyed by metric name, histograms as {upper bound ns: count}
+  inline void writeJson(std::ostream& out){
+    out<<"{\"enabled\": "<<(enabled() ? "true" : "false")<<", \"metrics\": {";
+    bool first = true;
+    registry().forEach([&](const Metric& m){
+      out<<(first ? "" : ", ")<<"\""<<m.name<<"\": {\"count\": "<<m.count.load();
+      first = false;
+      if(m.timed){
+        out<<", \"total_ns\": "<<m.totalNs.load()<<", \"max_ns\": "<<m.maxNs.load()
+           <<", \"p50_ns\": "<<m.quantileNs(0.5)<<", \"p99_ns\": "<<m.quantileNs(0.99)<<", \"histogram\": {";
+        bool firstBucket = true;
+        for(int i=0; i<BUCKETS; i++){
+          uint64_t n = m.buckets[i].load();
+          if(!n) continue;
+          out<<(firstBucket ? "" : ", ")<<"\""<<((2ULL<<i)-1)<<"\": "<<n;
+          firstBucket = false;
+        }
+        out<<"}";
+      }
+      out<<"}";
+    });
+    out<<"}}\n";
+  }
+}
+
+#ifdef PASSANOMIX_STATS
+#define STATS_JOIN2(a, b) a##b
+#define STATS_JOIN(a, b) STATS_JOIN2(a, b)
+#define STATS_TIMER(name) \
+  static Stats::Metric& STATS_JOIN(statsMetric, __LINE__) = Stats::registry().get(name, true); \
+  Stats::ScopedTimer STATS_JOIN(statsTimer, __LINE__)(STATS_JOIN(statsMetric, __LINE__))
+#define STATS_COUNT(name, n) \
+  do{ static Stats::Metric& statsCounter = Stats::registry().get(name, false); statsCounter.add(n); }while(0)
+#else
+#define STATS_TIMER(name) ((void)0)
+#define STATS_COUNT(name, n) ((void)0)
+#endif
+#endif
@@ -0,0 +1,201 @@
+// json_reader.h
+#ifndef JSON_READER_H
+#define JSON_READER_H
+#include<string>
+#include<string_view>
+#include<cstring>
+#include<climits>
+#include<stdexcept>
+
+// Single-pass pull tokenizer over an in-memory JSON buffer.
+// Keys are returned as string_view slices of the buffer, values are unescaped straight into caller strings.
+class JsonReader{
+private:
+  const char* cur;
+  const char* begin;
+  const char* end;
+  const char* context;  // Prefix for error messages
+
+  [[noreturn]] void fail(const char* what) const{
+    throw std::runtime_error(std::string(context)+": "+what+" at byte "+std::to_string(cur-begin));
+  }
+
+  void skipWhitespace(){
+    while(cur<end && (*cur==' ' || *cur=='\n' || *cur=='\r' || *cur=='\t')) cur++;
+  }
+
+  void expect(char c){
+    skipWhitespace();
+    if(cur>=end || *cur!=c) fail("unexpected character");
+    cur++;
+  }
+
+  static unsigned hexValue(char c){
+    if(c>='0' && c<='9') return c-'0';
+    if(c>='a' && c<='f') return c-'a'+10;
+    if(c>='A' && c<='F') return c-'A'+10;
+    return 16;
+  }
+
+  unsigned readHex4(){
+    if(end-cur<4) fail("truncated unicode escape");
+    unsigned value = 0;
+    for(int i=0; i<4; i++){
+      unsigned digit = hexValue(*cur++);
+      if(digit>15) fail("bad unicode escape");
+      value = (value<<4) | digit;
+    }
+    return value;
+  }
+
+  template<typename String>
+  static void appendUtf8(String& out, unsigned cp){
+    if(cp<0x80){
+      out += static_cast<char>(cp);
+    }else if(cp<0x800){
+      out += static_cast<char>(0xC0 | (cp>>6));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }else if(cp<0x10000){
+      out += static_cast<char>(0xE0 | (cp>>12));
+      out += static_cast<char>(0x80 | ((cp>>6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }else{
+      out += static_cast<char>(0xF0 | (cp>>18));
+      out += static_cast<char>(0x80 | ((cp>>12) & 0x3F));
+      out += static_cast<char>(0x80 | ((cp>>6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  }
+
+public:
+  JsonReader(const char* data, size_t size, const char* errorContext="Corrupted vault file")
+    : cur(data), begin(data), end(data+size), context(errorContext){}
+
+  // Returns the next significant character without consuming it, or 0 at end of input
+  char peek(){
+    skipWhitespace();
+    return cur<end ? *cur : 0;
+  }
+
+  bool atEnd(){
+    return peek()==0;
+  }
+
+  void beginObject(){
+    expect('{');
+  }
+
+  void beginArray(){
+    expect('[');
+  }
+
+  // Advances to the next member of the current object; returns false after consuming the closing brace
+  bool nextKey(std::string_view& key){
+    skipWhitespace();
+    if(cur<end && *cur=='}'){
+      cur++;
+      return false;
+    }
+    if(cur<end && *cur==',') cur++;
+    expect('"');
+    const char* start = cur;
+    const char* quote = static_cast<const char*>(std::memchr(cur, '"', end-cur));
+    if(!quote) fail("unterminated key");
+    key = std::string_view(start, quote-start);
+    cur = quote+1;
+    expect(':');
+    return true;
+  }
+
+  // Advances to the next element of the current array; returns false after consuming the closing bracket
+  bool nextElement(){
+    skipWhitespace();
+    if(cur<end && *cur==']'){
+      cur++;
+      return false;
+    }
+    if(cur<end && *cur==',') cur++;
+    if(peek()==0) fail("unterminated array");
+    return true;
+  }
+
+  // Reads a string value, unescaping directly into out (a std::string or SecureString)
+  template<typename String>
+  void readString(String& out){
+    expect('"');
+    out.clear();
+    while(true){
+      const char* special = cur;
+      while(special<end && *special!='"' && *special!='\\') special++;
+      out.append(cur, special-cur);
+      cur = special;
+      if(cur>=end) fail("unterminated string");
+      if(*cur++=='"') return;
+      if(cur>=end) fail("unterminated escape");
+      char c = *cur++;
+      switch(c){
+        case '"': out += '"'; break;
+        case '\\': out += '\\'; break;
+        case '/': out += '/'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u':{
+          unsigned cp = readHex4();
+          if(cp>=0xDC00 && cp<0xE000) fail("bad surrogate pair");
+          if(cp>=0xD800 && cp<0xDC00){
+            // A high surrogate must be followed by an escaped low one; either half alone isn't a character
+            if(end-cur<6 || cur[0]!='\\' || cur[1]!='u') fail("bad surrogate pair");
+            cur += 2;
+            unsigned low = readHex4();
+            if(low<0xDC00 || low>=0xE000) fail("bad surrogate pair");
+            cp = 0x10000 + ((cp-0xD800)<<10) + (low-0xDC00);
+          }
+          appendUtf8(out, cp);
+          break;
+        }
+        default: fail("bad escape");
+      }
+    }
+  }
+
+  // Reads a non-negative integer value, failing instead of wrapping when it exceeds max
+  unsigned long readUnsigned(unsigned long max=ULONG_MAX){
+    skipWhitespace();
+    if(cur>=end || *cur<'0' || *cur>'9') fail("expected number");
+    unsigned long value = 0;
+    while(cur<end && *cur>='0' && *cur<='9'){
+      unsigned digit = *cur - '0';
+      if(value>(max-digit)/10) fail("number out of range");
+      value = value*10 + digit;
+      cur++;
+    }
+    return value;
+  }
+
+  // Skips over any value, including nested objects and arrays
+  void skipValue(){
+    char c = peek();
+    if(c=='"'){
+      cur++;
+      while(cur<end && *cur!='"'){
+        if(*cur=='\\') cur++;
+        cur++;
+      }
+      if(cur>=end) fail("unterminated string");
+      cur++;
+    }else if(c=='{'){
+      cur++;
+      std::string_view key;
+      while(nextKey(key)) skipValue();
+    }else if(c=='['){
+      cur++;
+      while(nextElement()) skipValue();
+    }else{
+      while(cur<end && *cur!=',' && *cur!='}' && *cur!=']' && *cur!=' ' && *cur!='\n' && *cur!='\r' && *cur!='\t') cur++;
+    }
+  }
+};
+#endif
@@ -1,27 +1,11 @@
 // main.cpp
 #include<iostream>
-#include<termios.h>
-#include<unistd.h>
 #include "password_storage.h"
 #include "password_generator.h"
+#include "bulk_provisioner.h"
+#include "command_line.h"
 using namespace std;
 
-// Reads password without displaying on screen for security
-string getPasswordInput(const string& prompt){
-  cout<<prompt;
-  cout.flush();
-  termios oldt;
-  tcgetattr(STDIN_FILENO, &oldt);
-  termios newt = oldt;
-  newt.c_lflag &= ~ECHO;  // Disable terminal echo
-  tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-  string password;
-  getline(cin, password);
-  tcsetattr(STDIN_FILENO, TCSANOW, &oldt);  // Restore terminal echo
-  cout<<endl;
-  return password;
-}
-
 void printHeader(){
   cout<<"\n";
   cout<<"========================================\n";
@@ -37,21 +21,29 @@ void printMenu(){
   cout<<"2. Get a saved password\n";
   cout<<"3. See all your saved entries\n";
   cout<<"4. Delete an entry\n";
-  cout<<"5. Exit\n";
+  cout<<"5. Convert vault to JSON or binary format\n";
+  cout<<"6. Bulk-create entries from a spec file\n";
+  cout<<"7. Change master password\n";
+  cout<<"8. Search entries\n";
+  cout<<"9. Exit\n";
   cout<<"\nYour choice: ";
 }
 
-int main(){
+int main(int argc, char* argv[]){
+  if(argc>1 && CommandLine::isCommand(argv[1])){
+    return CommandLine().run(argc, argv);
+  }
   try{
+    string vaultFile = argc>1 ? argv[1] : "passwords_secure.json";
     printHeader();
     // Get and verify master password
-    string masterPassword = getPasswordInput("Enter your master password: ");
+    SecureString masterPassword = getPasswordInput("Enter your master password: ");
     if(masterPassword.length()<8){
       cout<<"\n[ERROR] Master password must be at least 8 characters!\n";
       return 1;
     }
     // Initialize storage with master password
-    PasswordStorage storage("passwords_secure.json", masterPassword);
+    PasswordStorage storage(vaultFile, masterPassword);
     cout<<"\nLoading your password vault...";
     try{
       storage.load();
@@ -61,6 +53,25 @@ int main(){
       cout<<"\n[WARNING] "<<e.what()<<"\n";
       cout<<"Starting with a fresh vault.\n";
     }
+    // Reject a wrong master password up front; the derived key is cached for the rest of the session
+    try{
+      storage.unlock();
+    }catch(const exception& e){
+      cout<<"\n[ERROR] "<<e.what()<<"!\n";
+      return 1;
+    }
+    // Upgrade entries from the per-entry PBKDF2 format to vault-key subkeys
+    if(storage.getLegacyEntryCount()>0){
+      cout<<"Upgrading "<<storage.getLegacyEntryCount()<<" entry(s) to the new vault format...";
+      try{
+        storage.migrateLegacyEntries();
+        storage.save();
+        cout<<" Done!\n";
+      }catch(const exception& e){
+        cout<<"\n[WARNING] "<<e.what()<<"\n";
+        cout<<"Legacy entries were left unchanged.\n";
+      }
+    }
     PasswordGenerator generator;
     // Main program loop
     while(true){
@@ -77,18 +88,20 @@ int main(){
         getline(cin, service);
         cout<<"Username or email: ";
         getline(cin, username);
-        cout<<"Password length (minimum 8): ";
+        cout<<"Password length (minimum 8, or 0 for a 6-word passphrase): ";
         cin>>length;
         cin.ignore();
         cout<<"Notes (optional, press Enter to skip): ";
         getline(cin, notes);
         try{
-          string password = generator.generate(length);
+          PasswordGenerator::PassphraseSpec passphrase;
+          SecureString password = length==0 ? generator.generatePassphrase(passphrase) : generator.generate(length);
           int strength = generator.calculateStrength(password);
           cout<<"\nGenerated Password: "<<password<<"\n";
           cout<<"Strength: "<<strength<<"/100 ("<<generator.getStrengthDescription(strength)<<")\n";
+          if(length==0) cout<<"Entropy: "<<static_cast<int>(passphrase.bits())<<" bits\n";
           storage.addEntry(service, username, password, notes);
-          storage.save();
+          storage.commit();
           cout<<"\n[SUCCESS] Password saved securely!\n";
         }catch(const exception& e){
           cout<<"\n[ERROR] "<<e.what()<<"\n";
@@ -102,30 +115,54 @@ int main(){
         cout<<"Username (press Enter to skip): ";
         getline(cin, username);
         try{
-          string password = storage.getPassword(service, username);
+          SecureString password = storage.getPassword(service, username);
           cout<<"\nPassword: "<<password<<"\n";
         }catch(const exception& e){
           cout<<"\n[ERROR] "<<e.what()<<"\n";
+          auto similar = storage.search(service, 5);
+          if(!similar.empty()){
+            cout<<"Did you mean:\n";
+            for(const auto& r : similar){
+              cout<<"  - "<<r.entry.service<<" ("<<r.entry.username<<")\n";
+            }
+          }
         }
       }else if(choice==3){
-        // List all entries
-        auto entries = storage.listEntries();
+        // List entries by service, a page at a time
+        const size_t PAGE = 20;
+        PasswordStorage::ListQuery query;
+        query.order = PasswordStorage::BY_SERVICE;
+        query.limit = PAGE;
         cout<<"\n========================================\n";
         cout<<"         Your Saved Passwords\n";
         cout<<"========================================\n\n";
-        if(entries.empty()){
-          cout<<"  (No passwords saved yet)\n";
-        }else{
-          for(size_t i=0; i<entries.size(); i++){
-            const auto& e = entries[i];
-            cout<<"  ["<<(i+1)<<"] "<<e.service<<"\n";
+        while(true){
+          size_t number = query.offset;
+          size_t total = storage.listPage(query, [&](const EntryMeta& e){
+            cout<<"  ["<<(++number)<<"] "<<e.service<<"\n";
             cout<<"      Username: "<<e.username<<"\n";
             cout<<"      Created: "<<e.timestamp<<"\n";
             if(!e.notes.empty()){
               cout<<"      Notes: "<<e.notes<<"\n";
             }
             cout<<"      ----------------------------\n";
+          });
+          if(total==0){
+            cout<<"  (No passwords saved yet)\n";
+            break;
+          }
+          if(total<=PAGE) break;
+          cout<<"\nShowing "<<(query.offset+1)<<"-"<<number<<" of "<<total<<". [n]ext, [p]revious or Enter to return: ";
+          string step;
+          getline(cin, step);
+          if(step=="n" && number<total){
+            query.offset += PAGE;
+          }else if(step=="p" && query.offset>0){
+            query.offset -= PAGE;
+          }else if(step!="n" && step!="p"){
+            break;
           }
+          cout<<"\n";
         }
       }else if(choice==4){
         // Delete entry
@@ -141,7 +178,7 @@ int main(){
         cin.ignore();
         if(confirm=='y' || confirm=='Y'){
           if(storage.deleteEntry(service, username)){
-            storage.save();
+            storage.commit();
             cout<<"\n[SUCCESS] Entry deleted successfully!\n";
           }else{
             cout<<"\n[ERROR] Entry not found!\n";
@@ -150,12 +187,85 @@ int main(){
           cout<<"\nDeletion cancelled.\n";
         }
       }else if(choice==5){
+        // Convert vault format
+        cout<<"\n--- Convert Vault ---\n";
+        cout<<"Current format: "<<(storage.isBinary() ? "binary" : "JSON")<<"\n";
+        string destination;
+        cout<<"Destination file (ending in .pvault for binary, otherwise JSON): ";
+        getline(cin, destination);
+        try{
+          if(destination.empty() || destination==vaultFile){
+            throw runtime_error("Choose a different destination file");
+          }
+          storage.saveAs(destination);
+          cout<<"\n[SUCCESS] Vault written to "<<destination<<"\n";
+        }catch(const exception& e){
+          cout<<"\n[ERROR] "<<e.what()<<"\n";
+        }
+      }else if(choice==6){
+        // Bulk provisioning
+        cout<<"\n--- Bulk Create Entries ---\n";
+        cout<<"Each line: service,username,length[,charsets[,notes]] (charsets: any of u,l,d,s or all)\n";
+        string specFile, threadsText;
+        cout<<"Spec file: ";
+        getline(cin, specFile);
+        cout<<"Worker threads (press Enter for one per core): ";
+        getline(cin, threadsText);
+        try{
+          auto specs = BulkProvisioner::readSpecs(specFile);
+          unsigned threads = threadsText.empty() ? 0 : stoul(threadsText);
+          auto result = BulkProvisioner::provision(storage, specs, threads);
+          cout<<"\n[SUCCESS] Created "<<result.created<<" entry(s) in "<<result.seconds<<" s";
+          if(result.seconds>0) cout<<" ("<<static_cast<long>(result.created/result.seconds)<<" entries/s)";
+          cout<<"\n";
+        }catch(const exception& e){
+          cout<<"\n[ERROR] "<<e.what()<<"\n";
+        }
+      }else if(choice==7){
+        // Change master password
+        cout<<"\n--- Change Master Password ---\n";
+        SecureString newMaster = getPasswordInput("New master password: ");
+        SecureString confirmMaster = getPasswordInput("Confirm new master password: ");
+        if(newMaster.length()<8){
+          cout<<"\n[ERROR] Master password must be at least 8 characters!\n";
+        }else if(newMaster!=confirmMaster){
+          cout<<"\n[ERROR] Passwords don't match!\n";
+        }else{
+          try{
+            storage.rekey(newMaster, 0, [](size_t done, size_t total){
+              cout<<"\rRe-encrypting entries: "<<done<<"/"<<total;
+              cout.flush();
+            });
+            cout<<"\n[SUCCESS] Master password changed!\n";
+          }catch(const exception& e){
+            cout<<"\n[ERROR] "<<e.what()<<"\n";
+            cout<<"The vault still uses your old master password.\n";
+          }
+        }
+      }else if(choice==8){
+        // Fuzzy search over service, username and notes
+        cout<<"\n--- Search Entries ---\n";
+        string query;
+        cout<<"Search for: ";
+        getline(cin, query);
+        auto results = storage.search(query, 10);
+        if(results.empty()){
+          cout<<"\n  (No matching entries)\n";
+        }
+        for(size_t i=0; i<results.size(); i++){
+          const auto& e = results[i].entry;
+          cout<<"  ["<<(i+1)<<"] "<<e.service<<" ("<<e.username<<")";
+          if(results[i].field==SearchIndex::NOTES) cout<<" - "<<e.notes;
+          cout<<"\n";
+        }
+      }else if(choice==9){
         // Exit program
         cout<<"\nThanks for using Passanomix!\n";
         cout<<"Stay safe online!\n\n";
+        if(Stats::enabled()) Stats::writeText(cerr);
         break;
       }else{
-        cout<<"\n[ERROR] Invalid choice! Please select 1-5.\n";
+        cout<<"\n[ERROR] Invalid choice! Please select 1-9.\n";
       }
     }
   }catch(const exception& e){
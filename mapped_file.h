@@ -0,0 +1,65 @@
+// mapped_file.h
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+#include<string>
+#include<stdexcept>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<fcntl.h>
+#include<unistd.h>
+
+// Read-only memory mapping of a whole file, unmapped on destruction
+class MappedFile{
+private:
+  const char* mapped = nullptr;
+  size_t length = 0;
+
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile(){
+    close();
+  }
+
+  // Maps path into memory; returns false if the file doesn't exist
+  bool open(const std::string& path, bool sequential=true){
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd<0) return false;
+    struct stat st;
+    if(::fstat(fd, &st)!=0){
+      ::close(fd);
+      throw std::runtime_error("Can't stat "+path);
+    }
+    length = st.st_size;
+    if(length>0){
+      void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(addr==MAP_FAILED){
+        ::close(fd);
+        length = 0;
+        throw std::runtime_error("Can't map "+path);
+      }
+      ::madvise(addr, length, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+      mapped = static_cast<const char*>(addr);
+    }
+    ::close(fd);  // The mapping stays valid after the descriptor is closed
+    return true;
+  }
+
+  void close(){
+    if(mapped) ::munmap(const_cast<char*>(mapped), length);
+    mapped = nullptr;
+    length = 0;
+  }
+
+  const char* data() const{
+    return mapped;
+  }
+
+  size_t size() const{
+    return length;
+  }
+};
+#endif
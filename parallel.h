@@ -0,0 +1,49 @@
+// parallel.h
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include<thread>
+#include<atomic>
+#include<vector>
+#include<exception>
+#include<mutex>
+#include<algorithm>
+
+// Minimal fork/join helpers for the bulk vault operations
+namespace Parallel{
+  // Number of worker threads to use when the caller doesn't specify one
+  inline unsigned defaultThreads(){
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+  }
+
+  // Calls fn(worker, begin, end) over [0, count) in chunks pulled from a shared counter.
+  // Each worker index runs on one thread, so per-worker state (RNG, cipher contexts) can be indexed by it.
+  // The first exception thrown by any worker is rethrown after all threads have joined.
+  template<typename Fn>
+  void forChunks(size_t count, unsigned threads, size_t chunk, Fn fn){
+    if(threads==0) threads = defaultThreads();
+    if(chunk==0) chunk = 1;
+    threads = std::max<size_t>(1, std::min<size_t>(threads, (count+chunk-1)/chunk));
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&](unsigned worker){
+      try{
+        size_t begin;
+        while((begin=next.fetch_add(chunk))<count){
+          fn(worker, begin, std::min(begin+chunk, count));
+        }
+      }catch(...){
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if(!error) error = std::current_exception();
+        next = count;  // Stop handing out work
+      }
+    };
+    std::vector<std::thread> pool;
+    for(unsigned w=1; w<threads; w++) pool.emplace_back(work, w);
+    work(0);  // The calling thread is worker 0
+    for(auto& t : pool) t.join();
+    if(error) std::rethrow_exception(error);
+  }
+}
+#endif
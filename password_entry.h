@@ -2,15 +2,46 @@
 #ifndef PASSWORD_ENTRY_H
 #define PASSWORD_ENTRY_H
 #include<string>
+#include<string_view>
+#include<cctype>
+#include<cstddef>
 
 // Structure to hold password information
 struct PasswordEntry{
+  std::string id;                 // Base64-encoded entry ID for vault-key entries (empty for legacy entries)
   std::string service;            // Service name (e.g., Gmail, GitHub)
   std::string username;           // Username or email
   std::string encryptedPassword;  // Base64-encoded encrypted password
-  std::string salt;               // Base64-encoded salt used in encryption
+  std::string salt;               // Base64-encoded per-entry PBKDF2 salt (legacy entries only)
   std::string iv;                 // Base64-encoded initialization vector
+  std::string cipher;             // Cipher suite of a vault-key entry ("aes-256-gcm", ...); empty for AES-256-CBC
   std::string timestamp;          // Creation timestamp
   std::string notes;              // Optional notes
 };
+
+// The displayable fields of an entry, viewed in place. Views stay valid until the vault is next modified or loaded.
+struct EntryMeta{
+  std::string_view service;
+  std::string_view username;
+  std::string_view timestamp;
+  std::string_view notes;
+  size_t position;                // Index of the entry in the vault
+};
+
+// Lowercases ASCII letters for case-insensitive service and username matching
+inline std::string foldCase(const std::string& str){
+  std::string folded(str);
+  for(auto& c : folded) c = std::tolower(static_cast<unsigned char>(c));
+  return folded;
+}
+
+// Compares like foldCase(a) against foldCase(b), without building either
+inline int compareFolded(std::string_view a, std::string_view b){
+  size_t n = a.size()<b.size() ? a.size() : b.size();
+  for(size_t i=0; i<n; i++){
+    int x = std::tolower(static_cast<unsigned char>(a[i])), y = std::tolower(static_cast<unsigned char>(b[i]));
+    if(x!=y) return x<y ? -1 : 1;
+  }
+  return a.size()==b.size() ? 0 : (a.size()<b.size() ? -1 : 1);
+}
 #endif
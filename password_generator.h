@@ -2,16 +2,126 @@
 #ifndef PASSWORD_GENERATOR_H
 #define PASSWORD_GENERATOR_H
 #include<string>
-#include<random>
+#include<string_view>
+#include<vector>
+#include<array>
 #include<algorithm>
 #include<stdexcept>
+#include<cstdint>
+#include<cmath>
 #include<cctype>
+#include<openssl/rand.h>
+#include "secure_memory.h"
+#include "strength_estimator.h"
+#include "wordlist.h"
+
+// Passwords generated by generateBatch, stored back to back in one buffer
+struct PasswordBatch{
+  SecureString buffer;
+  size_t count = 0;
+  int length = 0;            // Length of every password when ends is empty
+  std::vector<size_t> ends;  // End of each password in buffer, for passphrases of varying length
+
+  std::string_view operator[](size_t i) const{
+    if(ends.empty()) return std::string_view(buffer.data()+i*length, length);
+    size_t begin = i ? ends[i-1] : 0;
+    return std::string_view(buffer.data()+begin, ends[i]-begin);
+  }
+};
 
 class PasswordGenerator{
 private:
-  std::random_device rd;
-  std::mt19937 gen;  // Mersenne Twister random number generator
-  
+  static const size_t POOL_SIZE = 16384;  // Random bytes fetched per RAND_bytes call
+  SecureBytes pool;  // Unused pool bytes would reveal future passwords; zeroed by the allocator
+  size_t poolPos = POOL_SIZE;
+
+  // Precomputed alphabet for one combination of character sets
+  struct Alphabet{
+    std::string chars;                   // All selected characters
+    std::vector<std::string_view> sets;  // Each selected set, one required character is drawn from each
+  };
+
+  static const std::array<Alphabet, 16>& alphabets(){
+    static const std::array<Alphabet, 16> table = [](){
+      static const char* const sets[] = {
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+        "abcdefghijklmnopqrstuvwxyz",
+        "0123456789",
+        "!@#$%^&*()-_=+[]{}|;:,.<>?/"
+      };
+      std::array<Alphabet, 16> built;
+      for(int mask=0; mask<16; mask++){
+        for(int i=0; i<4; i++){
+          if(mask & (1<<i)){
+            built[mask].chars += sets[i];
+            built[mask].sets.emplace_back(sets[i]);
+          }
+        }
+      }
+      return built;
+    }();
+    return table;
+  }
+
+  unsigned char nextByte(){
+    if(poolPos==POOL_SIZE){
+      if(RAND_bytes(pool.data(), POOL_SIZE)!=1){
+        throw std::runtime_error("Failed to generate random bytes");
+      }
+      poolPos = 0;
+    }
+    return pool[poolPos++];
+  }
+
+  // Returns a uniform value in [0, bound) for bound<=256, rejecting bytes that would cause modulo bias
+  unsigned uniform(unsigned bound){
+    unsigned limit = 256 - 256%bound;
+    unsigned char b;
+    do{
+      b = nextByte();
+    }while(b>=limit);
+    return b%bound;
+  }
+
+  // Returns a uniform value in [0, bound) for bound<=2^24, from three pool bytes with rejection
+  uint32_t uniformWide(uint32_t bound){
+    const uint32_t range = 1u<<24;
+    uint32_t limit = range - range%bound, value;
+    do{
+      value = nextByte() | nextByte()<<8 | static_cast<uint32_t>(nextByte())<<16;
+    }while(value>=limit);
+    return value%bound;
+  }
+
+  // Writes one password of length characters into out
+  void generateInto(char* out, int length, const Alphabet& alphabet){
+    int pos = 0;
+    for(auto set : alphabet.sets){  // Ensure at least one char from each selected set
+      out[pos++] = set[uniform(set.size())];
+    }
+    unsigned size = alphabet.chars.size();
+    for(; pos<length; pos++){
+      out[pos] = alphabet.chars[uniform(size)];
+    }
+    for(int i=length-1; i>0; i--){  // Fisher-Yates shuffle to randomize required characters
+      std::swap(out[i], out[uniform(i+1)]);
+    }
+  }
+
+  static const Alphabet& checkedAlphabet(int length, int charsets){
+    if(length<8){
+      throw std::invalid_argument("Password must be at least 8 characters long");
+    }
+    if(length>256){
+      throw std::invalid_argument("Password must be at most 256 characters long");
+    }
+    const Alphabet& alphabet = alphabets()[charsets & 15];
+    if(alphabet.chars.empty()){
+      throw std::invalid_argument("At least one character set must be selected");
+    }
+    return alphabet;
+  }
+
 public:
   // Character set flags that can be combined
   enum CharacterSet{
@@ -22,66 +132,132 @@ public:
     ALL = UPPERCASE | LOWERCASE | DIGITS | SPECIAL
   };
 
-  PasswordGenerator() : gen(rd()){}
+  // Capitalization of passphrase words
+  enum Capitalization{
+    LOWER,        // "maple-harbor"
+    TITLE,        // "Maple-Harbor"
+    RANDOM_CASE   // Each word's first letter upper or lower at random, one more bit per word
+  };
+
+  // Shape of a generated passphrase
+  struct PassphraseSpec{
+    int words = 6;
+    std::string separator = "-";
+    Capitalization capitalization = LOWER;
+    int extra = 0;  // DIGITS and/or SPECIAL: one such character is added after a random word
 
-  // Generates a random password with specified length and character sets
-  std::string generate(int length, int charsets=ALL){
-    if(length<8){
-      throw std::invalid_argument("Password must be at least 8 characters long");
+    // Longest passphrase of this shape; words vary in length, so most are shorter
+    size_t maxLength() const{
+      return words*Wordlist::MAX_LENGTH + (words-1)*separator.size() + (extra ? 1 : 0);
     }
-    const std::string upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    const std::string lower = "abcdefghijklmnopqrstuvwxyz";
-    const std::string digits = "0123456789";
-    const std::string special = "!@#$%^&*()-_=+[]{}|;:,.<>?/";
-    std::string charset;
-    std::string required;  // Ensure at least one char from each selected set
-    if(charsets & UPPERCASE){
-      charset += upper;
-      required += upper[std::uniform_int_distribution<>(0, upper.length()-1)(gen)];
-    }
-    if(charsets & LOWERCASE){
-      charset += lower;
-      required += lower[std::uniform_int_distribution<>(0, lower.length()-1)(gen)];
-    }
-    if(charsets & DIGITS){
-      charset += digits;
-      required += digits[std::uniform_int_distribution<>(0, digits.length()-1)(gen)];
-    }
-    if(charsets & SPECIAL){
-      charset += special;
-      required += special[std::uniform_int_distribution<>(0, special.length()-1)(gen)];
-    }
-    if(charset.empty()){
-      throw std::invalid_argument("At least one character set must be selected");
+
+    // Exact entropy in bits: words are equally likely and every choice gives a different passphrase
+    double bits() const{
+      double total = words*std::log2(static_cast<double>(Wordlist::SIZE));
+      if(capitalization==RANDOM_CASE) total += words;
+      if(extra){
+        total += std::log2(static_cast<double>(alphabets()[extra & (DIGITS | SPECIAL)].chars.size()));
+        total += std::log2(static_cast<double>(words));
+      }
+      return total;
+    }
+  };
+
+private:
+  // Writes one passphrase of at most spec.maxLength() characters into out and returns its end
+  char* passphraseInto(char* out, const PassphraseSpec& spec){
+    int extraAt = spec.extra ? uniform(spec.words) : -1;  // Word the extra character follows
+    std::string_view extras = alphabets()[spec.extra & (DIGITS | SPECIAL)].chars;
+    for(int w=0; w<spec.words; w++){
+      if(w>0){
+        out = std::copy(spec.separator.begin(), spec.separator.end(), out);
+      }
+      std::string_view word = Wordlist::WORDS[uniformWide(Wordlist::SIZE)];
+      char* first = out;
+      out = std::copy(word.begin(), word.end(), out);
+      if(spec.capitalization==TITLE || (spec.capitalization==RANDOM_CASE && (nextByte() & 1))){
+        *first = std::toupper(static_cast<unsigned char>(*first));
+      }
+      if(w==extraAt) *out++ = extras[uniform(extras.size())];
+    }
+    return out;
+  }
+
+  static void checkPassphrase(const PassphraseSpec& spec){
+    if(spec.words<3 || spec.words>20){
+      throw std::invalid_argument("Passphrase must have 3 to 20 words");
+    }
+    if(spec.separator.size()>8){
+      throw std::invalid_argument("Passphrase separator must be at most 8 characters");
+    }
+    // Letters in the separator could run into the words and make two passphrases look alike
+    if(std::any_of(spec.separator.begin(), spec.separator.end(), [](unsigned char c){ return std::isalpha(c); })){
+      throw std::invalid_argument("Passphrase separator can't contain letters");
     }
-    std::string password = required;
-    std::uniform_int_distribution<> dist(0, charset.length()-1);
-    for(int i=required.length(); i<length; i++){
-      password += charset[dist(gen)];
+    // Without a separator or capitals marking where each word starts, "sun"+"rise" and "sunrise" collide
+    if(spec.separator.empty() && spec.capitalization!=TITLE){
+      throw std::invalid_argument("Passphrase words need a separator unless they are title case");
     }
-    std::shuffle(password.begin(), password.end(), gen);  // Shuffle to randomize required characters
+    if(spec.extra & ~(DIGITS | SPECIAL)){
+      throw std::invalid_argument("The extra passphrase character must be a digit or a symbol");
+    }
+  }
+
+public:
+  PasswordGenerator() : pool(POOL_SIZE){}
+
+  PasswordGenerator(const PasswordGenerator&) = delete;
+  PasswordGenerator& operator=(const PasswordGenerator&) = delete;
+
+  // Generates a random password with specified length and character sets
+  SecureString generate(int length, int charsets=ALL){
+    const Alphabet& alphabet = checkedAlphabet(length, charsets);
+    SecureString password(length, '\0');
+    generateInto(&password[0], length, alphabet);
     return password;
   }
 
-  // Calculates password strength on a scale of 0-100
-  int calculateStrength(const std::string& password){
-    int strength = 0;
-    bool hasUpper=false, hasLower=false, hasDigit=false, hasSpecial=false;
-    for(char c : password){
-      if(std::isupper(c)) hasUpper = true;
-      else if(std::islower(c)) hasLower = true;
-      else if(std::isdigit(c)) hasDigit = true;
-      else hasSpecial = true;
-    }
-    // Award points for character diversity
-    if(hasUpper) strength += 20;
-    if(hasLower) strength += 20;
-    if(hasDigit) strength += 20;
-    if(hasSpecial) strength += 20;
-    // Award points for length
-    if(password.length()>=12) strength += 10;
-    if(password.length()>=16) strength += 10;
-    return strength;
+  // Generates count passwords into one contiguous buffer, sharing the random pool and alphabet
+  PasswordBatch generateBatch(size_t count, int length, int charsets=ALL){
+    const Alphabet& alphabet = checkedAlphabet(length, charsets);
+    PasswordBatch batch;
+    batch.count = count;
+    batch.length = length;
+    batch.buffer.resize(count*length);
+    for(size_t i=0; i<count; i++){
+      generateInto(&batch.buffer[i*length], length, alphabet);
+    }
+    return batch;
+  }
+
+  // Generates a passphrase of spec.words words drawn uniformly from the built-in wordlist
+  SecureString generatePassphrase(const PassphraseSpec& spec){
+    checkPassphrase(spec);
+    SecureString passphrase(spec.maxLength(), '\0');
+    passphrase.resize(passphraseInto(&passphrase[0], spec)-passphrase.data());
+    return passphrase;
+  }
+
+  // Generates count passphrases into one contiguous buffer, each ending where batch.ends says
+  PasswordBatch generatePassphraseBatch(size_t count, const PassphraseSpec& spec){
+    checkPassphrase(spec);
+    PasswordBatch batch;
+    batch.count = count;
+    batch.ends.reserve(count);
+    batch.buffer.resize(count*spec.maxLength());  // Sized for the longest so the buffer is never reallocated
+    char* out = &batch.buffer[0];
+    for(size_t i=0; i<count; i++){
+      out = passphraseInto(out, spec);
+      batch.ends.push_back(out-batch.buffer.data());
+    }
+    batch.buffer.resize(out-batch.buffer.data());
+    return batch;
+  }
+
+  // Calculates password strength on a scale of 0-100 from its estimated entropy, so dictionary words,
+  // keyboard walks, sequences, repeats and dates count for little however many character classes they mix
+  int calculateStrength(std::string_view password){
+    return StrengthEstimator::instance().estimate(password).score;
   }
 
   // Returns human-readable strength description
@@ -3,22 +3,528 @@
 #define PASSWORD_STORAGE_H
 #include<string>
 #include<vector>
-#include<fstream>
 #include<sstream>
+#include<string_view>
+#include<cstring>
 #include<ctime>
 #include<algorithm>
+#include<unordered_map>
+#include<set>
+#include<memory>
+#include<functional>
+#include<atomic>
+#include<mutex>
+#include<chrono>
+#include<cstdint>
+#include<sys/stat.h>
+#include "instrumentation.h"
 #include "encryption.h"
+#include "secure_memory.h"
 #include "base64.h"
+#include "durable_file.h"
+#include "mapped_file.h"
+#include "json_reader.h"
+#include "binary_vault.h"
+#include "parallel.h"
 #include "password_entry.h"
+#include "strength_estimator.h"
+#include "search_index.h"
 
 class PasswordStorage{
+public:
+  // Per-thread cipher contexts and scratch buffers, so bulk loops encrypt without allocating per entry
+  struct CryptoWorker{
+    Encryption::Session session;
+    std::vector<unsigned char> id, ciphertext, scratch;
+    SecureBytes plaintext;
+    unsigned char key[Encryption::KEY_SIZE];
+    unsigned char iv[Encryption::IV_SIZE];  // Large enough for every cipher's IV
+
+    void wipeKey(){
+      OPENSSL_cleanse(key, sizeof(key));
+    }
+
+    void wipePlaintext(){
+      OPENSSL_cleanse(plaintext.data(), plaintext.size());
+    }
+
+    ~CryptoWorker(){
+      wipeKey();
+      wipePlaintext();
+    }
+  };
+
+  // Order of listPage() results; ties keep vault order
+  enum ListOrder{BY_POSITION, BY_SERVICE, BY_TIMESTAMP};
+
+  // One page of a listing
+  struct ListQuery{
+    ListOrder order = BY_POSITION;
+    bool descending = false;
+    std::string servicePrefix;  // Only services starting with this, ignoring case
+    size_t offset = 0;
+    size_t limit = SIZE_MAX;
+  };
+
+  // An entry flagged by audit()
+  struct AuditFinding{
+    std::string service, username;
+    int score = 0;                    // StrengthEstimator score, -1 if the entry couldn't be decrypted
+    double bits = 0;
+    StrengthEstimator::Pattern weakest = StrengthEstimator::BRUTEFORCE;
+    size_t reuseCount = 1;            // Entries with this password, this one included
+    size_t reuseGroup = 0;            // Entries sharing a password have the same non-zero group
+  };
+
+  struct AuditReport{
+    size_t scanned = 0, weak = 0, reused = 0, reuseGroups = 0, unreadable = 0;
+    double seconds = 0;
+    std::vector<AuditFinding> findings;  // Weak, reused and unreadable entries, by service and username
+  };
+
 private:
+  static const size_t JOURNAL_COMPACT_MIN = 256;  // Journal records tolerated before compacting into a snapshot
+
   std::string filename;
-  std::string masterPassword;
+  SecureString masterPassword;
   std::vector<PasswordEntry> entries;
+  std::vector<unsigned char> vaultSalt;     // Salt for the vault master key, stored in the file header
+  Encryption::KdfParams vaultKdf;           // Master key derivation parameters from the file header
+  SecureBytes vaultKey;                     // Master key derived once at unlock
+  std::vector<unsigned char> vaultKeyCheck; // Verifier for vaultKey from the file header; empty for older vaults
+  unsigned long generation = 0;             // Snapshot generation; journal records from other generations are stale
+  bool snapshotCurrent = false;             // True once the file on disk has the current header format
+  std::vector<std::string> pendingRecords;  // Journal records not yet committed
+  size_t journalRecords = 0;                // Records appended since the last compaction
+  // Lookup indexes over entry positions, kept in sync by every mutation
+  std::unordered_map<std::string, std::vector<size_t>> keyIndex;     // (service, username) -> positions
+  std::unordered_map<std::string, std::vector<size_t>> foldedIndex;  // Lowercased service -> positions
+  std::unordered_map<std::string, size_t> idIndex;                   // Entry ID -> position
+  std::set<std::string> foldedServices;                              // Sorted lowercased services for prefix lookups
+  SearchIndex searchIndex;                  // Trigrams of service, username and notes by position; built lazily for mapped vaults
+  std::vector<uint32_t> listOrders[3];      // Positions sorted per ListOrder (BY_POSITION unused); built on first listing, dropped on change
+  bool binaryFormat = false;                // Snapshots are written as a binary vault instead of JSON
+  std::unique_ptr<BinaryVault> mapped;      // Binary vault read lazily; entries stay empty until materialize()
+  DurableFile::Stamp vaultStamp;            // Vault and journal files as last read or written by this storage
+  DurableFile::Stamp journalStamp;
+  std::unique_ptr<DurableFile::FileLock> fileLock;  // Cross-process lock while held, see lockFile()
+  int fileLockDepth = 0;
+  CryptoWorker crypto;                      // Cipher contexts for single-threaded operations
+
+  static bool hasBinaryExtension(const std::string& path){
+    std::string ext = BinaryVault::EXTENSION;
+    return path.size()>=ext.size() && path.compare(path.size()-ext.size(), ext.size(), ext)==0;
+  }
+
+  // Picks a binary vault record for service and optional username, preferring an exact match
+  bool findMapped(const std::string& service, const std::string& username, size_t& index) const{
+    auto candidates = mapped->findService(service);
+    for(size_t i : candidates){
+      auto rec = mapped->record(i);
+      if(rec.service==service && (username.empty() || rec.username==username)){
+        index = i;
+        return true;
+      }
+    }
+    std::string foldedUser = foldCase(username);
+    for(size_t i : candidates){
+      if(username.empty() || foldCase(std::string(mapped->record(i).username))==foldedUser){
+        index = i;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Writes a full snapshot of the vault to path as JSON or binary
+  void writeSnapshot(const std::string& path, bool binary){
+    STATS_TIMER("storage.write_snapshot");
+    if(binary){
+      BinaryVault::Header params;
+      params.kdf = vaultKdf;
+      params.generation = generation;
+      params.salt = vaultSalt;
+      params.keyCheck = vaultKeyCheck;
+      BinaryVault::write(path, params, entries);
+      return;
+    }
+    std::ostringstream file;
+    file<<"{\n";
+    file<<"  \"vault\": {\n";
+    file<<"    \"version\": 2,\n";
+    file<<"    \"kdf\": \""<<Encryption::kdfName(vaultKdf.algorithm)<<"\",\n";
+    file<<"    \"iterations\": "<<vaultKdf.iterations<<",\n";
+    file<<"    \"memory\": "<<vaultKdf.memoryKiB<<",\n";
+    file<<"    \"parallelism\": "<<vaultKdf.parallelism<<",\n";
+    file<<"    \"generation\": "<<generation<<",\n";
+    file<<"    \"salt\": \""<<Base64::encode(vaultSalt)<<"\",\n";
+    file<<"    \"check\": \""<<Base64::encode(vaultKeyCheck)<<"\"\n";
+    file<<"  },\n";
+    file<<"  \"entries\": [\n";
+    for(size_t i=0; i<entries.size(); i++){
+      file<<"    {\n      ";
+      writeEntryFields(file, entries[i], "\n      ");
+      file<<"\n    }"<<(i<entries.size()-1 ? "," : "")<<"\n";
+    }
+    file<<"  ]\n";
+    file<<"}\n";
+    DurableFile::writeAtomic(path, file.str());
+  }
+
+  static std::string indexKey(const std::string& service, const std::string& username){
+    return service+'\x1f'+username;
+  }
+
+  static void erasePosition(std::vector<size_t>& positions, size_t pos){
+    auto it = std::find(positions.begin(), positions.end(), pos);
+    if(it!=positions.end()) positions.erase(it);
+  }
+
+  void dropListOrders(){
+    for(auto& order : listOrders) order.clear();
+  }
+
+  // Adds the entry at pos to every index
+  void indexEntry(size_t pos){
+    dropListOrders();
+    const auto& e = entries[pos];
+    keyIndex[indexKey(e.service, e.username)].push_back(pos);
+    std::string folded = foldCase(e.service);
+    auto& bucket = foldedIndex[folded];
+    if(bucket.empty()) foldedServices.insert(folded);
+    bucket.push_back(pos);
+    if(!e.id.empty()) idIndex[e.id] = pos;
+  }
+
+  // Removes the entry at pos from every index
+  void unindexEntry(size_t pos){
+    dropListOrders();
+    const auto& e = entries[pos];
+    auto key = keyIndex.find(indexKey(e.service, e.username));
+    if(key!=keyIndex.end()){
+      erasePosition(key->second, pos);
+      if(key->second.empty()) keyIndex.erase(key);
+    }
+    std::string folded = foldCase(e.service);
+    auto bucket = foldedIndex.find(folded);
+    if(bucket!=foldedIndex.end()){
+      erasePosition(bucket->second, pos);
+      if(bucket->second.empty()){
+        foldedIndex.erase(bucket);
+        foldedServices.erase(folded);
+      }
+    }
+    if(!e.id.empty()) idIndex.erase(e.id);
+  }
+
+  // Indexes the entry just appended to entries, including its trigrams
+  void indexAppended(){
+    const auto& e = entries.back();
+    indexEntry(entries.size()-1);
+    searchIndex.add(e.service, e.username, e.notes);
+  }
+
+  void rebuildIndex(){
+    STATS_TIMER("storage.rebuild_index");
+    keyIndex.clear();
+    foldedIndex.clear();
+    idIndex.clear();
+    foldedServices.clear();
+    searchIndex.clear();
+    dropListOrders();
+    keyIndex.reserve(entries.size());
+    foldedIndex.reserve(entries.size());
+    idIndex.reserve(entries.size());
+    searchIndex.reserve(entries.size());
+    for(size_t i=0; i<entries.size(); i++){
+      indexEntry(i);
+      searchIndex.add(entries[i].service, entries[i].username, entries[i].notes);
+    }
+  }
+
+  // Removes the entry at pos in O(1) by moving the last entry into its slot
+  void removeAt(size_t pos){
+    size_t last = entries.size()-1;
+    unindexEntry(pos);
+    searchIndex.remove(pos);  // Performs the same move
+    if(pos!=last){
+      unindexEntry(last);
+      entries[pos] = std::move(entries[last]);
+      entries.pop_back();
+      indexEntry(pos);
+    }else{
+      entries.pop_back();
+    }
+  }
+
+  // Positions of entries matching service and optional username exactly
+  std::vector<size_t> findExact(const std::string& service, const std::string& username) const{
+    if(!username.empty()){
+      auto key = keyIndex.find(indexKey(service, username));
+      return key==keyIndex.end() ? std::vector<size_t>() : key->second;
+    }
+    std::vector<size_t> positions;
+    auto bucket = foldedIndex.find(foldCase(service));
+    if(bucket==foldedIndex.end()) return positions;
+    for(size_t pos : bucket->second){
+      if(entries[pos].service==service) positions.push_back(pos);
+    }
+    return positions;
+  }
+
+  // Positions of entries matching service and optional username ignoring case
+  std::vector<size_t> findFolded(const std::string& service, const std::string& username) const{
+    std::vector<size_t> positions;
+    auto bucket = foldedIndex.find(foldCase(service));
+    if(bucket==foldedIndex.end()) return positions;
+    std::string foldedUser = foldCase(username);
+    for(size_t pos : bucket->second){
+      if(username.empty() || foldCase(entries[pos].username)==foldedUser) positions.push_back(pos);
+    }
+    return positions;
+  }
+
+  EntryMeta metaAt(size_t pos) const{
+    if(mapped){
+      auto rec = mapped->record(pos);
+      return EntryMeta{rec.service, rec.username, rec.timestamp, rec.notes, pos};
+    }
+    const auto& e = entries[pos];
+    return EntryMeta{e.service, e.username, e.timestamp, e.notes, pos};
+  }
+
+  // Positions sorted for order, sorted once and then reused until the vault changes
+  const std::vector<uint32_t>& listOrder(ListOrder order){
+    auto& sorted = listOrders[order];
+    size_t count = getEntryCount();
+    if(sorted.size()==count) return sorted;
+    STATS_TIMER("storage.sort_listing");
+    std::vector<std::string_view> keys(count), ties(count);
+    for(size_t i=0; i<count; i++){
+      EntryMeta meta = metaAt(i);
+      keys[i] = order==BY_SERVICE ? meta.service : meta.timestamp;
+      ties[i] = order==BY_SERVICE ? meta.username : meta.service;
+    }
+    sorted.resize(count);
+    for(size_t i=0; i<count; i++) sorted[i] = i;
+    // Services ignore case; timestamps are "YYYY-MM-DD HH:MM:SS" and sort as text
+    auto compare = [order](std::string_view a, std::string_view b){ return order==BY_SERVICE ? compareFolded(a, b) : a.compare(b); };
+    std::sort(sorted.begin(), sorted.end(), [&](uint32_t a, uint32_t b){
+      int c = compare(keys[a], keys[b]);
+      if(c==0) c = compareFolded(ties[a], ties[b]);
+      return c!=0 ? c<0 : a<b;
+    });
+    return sorted;
+  }
+
+  std::string journalFilename() const{
+    return filename+".journal";
+  }
+
+  // Writes entry fields as JSON members separated by sep
+  static void writeEntryFields(std::ostream& out, const PasswordEntry& e, const char* sep){
+    out<<"\"id\": \""<<escapeJson(e.id)<<"\","<<sep;
+    out<<"\"service\": \""<<escapeJson(e.service)<<"\","<<sep;
+    out<<"\"username\": \""<<escapeJson(e.username)<<"\","<<sep;
+    out<<"\"password\": \""<<escapeJson(e.encryptedPassword)<<"\","<<sep;
+    out<<"\"salt\": \""<<escapeJson(e.salt)<<"\","<<sep;
+    out<<"\"iv\": \""<<escapeJson(e.iv)<<"\","<<sep;
+    out<<"\"cipher\": \""<<escapeJson(e.cipher)<<"\","<<sep;
+    out<<"\"timestamp\": \""<<escapeJson(e.timestamp)<<"\","<<sep;
+    out<<"\"notes\": \""<<escapeJson(e.notes)<<"\"";
+  }
+
+  // Journal record body for an added or updated entry
+  static std::string entryRecord(const char* op, const PasswordEntry& e){
+    std::ostringstream record;
+    record<<"\"op\": \""<<op<<"\", ";
+    writeEntryFields(record, e, " ");
+    return record.str();
+  }
+
+  static std::string deleteRecord(const std::string& service, const std::string& username){
+    return "\"op\": \"delete\", \"service\": \""+escapeJson(service)+"\", \"username\": \""+escapeJson(username)+"\"";
+  }
+
+  // Queues a journal record for an added or updated entry
+  void journalEntry(const char* op, const PasswordEntry& e){
+    pendingRecords.push_back(entryRecord(op, e));
+  }
+
+  // Journal lines for record bodies, tagged with the current generation
+  std::string journalText(const std::vector<std::string>& records) const{
+    std::string text;
+    for(const auto& record : records) text += "{\"gen\": "+std::to_string(generation)+", "+record+"}\n";
+    return text;
+  }
+
+  // Copies out the first entry matching service and optional username exactly, without materializing
+  bool exactEntry(const std::string& service, const std::string& username, PasswordEntry& found) const{
+    if(mapped){
+      for(size_t i : mapped->findService(service)){
+        auto rec = mapped->record(i);
+        if(rec.service==service && (username.empty() || rec.username==username)){
+          found = mapped->entry(i);
+          return true;
+        }
+      }
+      return false;
+    }
+    auto positions = findExact(service, username);
+    if(positions.empty()) return false;
+    found = entries[positions.front()];
+    return true;
+  }
+
+  // Removes entries matching service and optional username
+  bool removeMatching(const std::string& service, const std::string& username){
+    auto positions = findExact(service, username);
+    std::sort(positions.rbegin(), positions.rend());  // Highest first so swapped-in entries are never matches
+    for(size_t pos : positions) removeAt(pos);
+    return !positions.empty();
+  }
+
+  // Replaces the encrypted fields of the entry with the same ID
+  bool replaceById(const PasswordEntry& updated){
+    auto it = idIndex.find(updated.id);
+    if(updated.id.empty() || it==idIndex.end()) return false;
+    size_t pos = it->second;
+    unindexEntry(pos);
+    entries[pos] = updated;
+    indexEntry(pos);
+    return true;
+  }
+
+  // Builds encrypted entry fields for a password, keeping the entry ID or assigning a fresh one
+  void encryptInto(PasswordEntry& entry, std::string_view password){
+    unlock();
+    sealInto(crypto, entry, password);
+  }
+
+  // The const worker paths use the vault key unlock() derived and can't derive it themselves
+  void requireUnlocked() const{
+    if(vaultKey.empty()){
+      throw std::logic_error("Vault is locked");
+    }
+  }
+
+  // Encrypts under the already derived vault key; touches no mutable state except worker
+  void sealInto(CryptoWorker& worker, PasswordEntry& entry, std::string_view password) const{
+    requireUnlocked();
+    sealWithKey(worker, entry, password, vaultKey);
+  }
+
+  // Decodes Base64 text into a reused scratch buffer
+  static void decodeField(const std::string& text, std::vector<unsigned char>& out){
+    out.resize(text.size()/4*3 + 32);
+    out.resize(Base64::decodeInto(text.data(), text.size(), out.data()));
+  }
+
+  // Encodes bytes as Base64 into field, reusing its capacity
+  static void encodeField(const unsigned char* data, size_t size, std::string& field){
+    field.resize(Base64::encodedLength(size));
+    Base64::encodeInto(data, size, &field[0]);
+  }
+
+  // Encrypts an entry under a subkey of masterKey with the preferred AEAD cipher, keeping the entry ID or
+  // assigning a fresh one. The raw entry ID is authenticated as associated data, so a ciphertext can't be
+  // moved onto another entry.
+  static void sealWithKey(CryptoWorker& worker, PasswordEntry& entry, std::string_view password, const SecureBytes& masterKey){
+    Encryption::Cipher cipher = Encryption::preferredCipher();
+    int ivSize = Encryption::ivSize(cipher);
+    if(entry.id.empty()){
+      worker.id.resize(Encryption::ENTRY_ID_SIZE);
+      Encryption::randomInto(worker.id.data(), worker.id.size());
+    }else{
+      decodeField(entry.id, worker.id);
+    }
+    Encryption::deriveEntryKeyInto(masterKey.data(), masterKey.size(), worker.id.data(), worker.id.size(), worker.key);
+    Encryption::randomInto(worker.iv, ivSize);
+    worker.ciphertext.resize(password.size() + Encryption::BLOCK_SIZE);
+    size_t len;
+    try{
+      len = worker.session.encryptInto(cipher, worker.key, worker.iv, worker.id.data(), worker.id.size(),
+                                       reinterpret_cast<const unsigned char*>(password.data()), password.size(), worker.ciphertext.data(), worker.ciphertext.size());
+    }catch(...){
+      worker.wipeKey();
+      throw;
+    }
+    worker.wipeKey();
+    encodeField(worker.id.data(), worker.id.size(), entry.id);
+    encodeField(worker.ciphertext.data(), len, entry.encryptedPassword);
+    entry.salt.clear();
+    encodeField(worker.iv, ivSize, entry.iv);
+    entry.cipher = Encryption::cipherName(cipher);
+  }
+
+  // Decrypts an entry into plaintext under a subkey of masterKey, or with per-entry PBKDF2 of password for legacy entries
+  static void openWithKey(CryptoWorker& worker, const PasswordEntry& entry, const SecureBytes& masterKey, std::string_view password, SecureString& plaintext){
+    if(entry.id.empty()){
+      Encryption::EncryptedData data;
+      data.ciphertext = Base64::decode(entry.encryptedPassword);
+      data.iv = Base64::decode(entry.iv);
+      data.salt = Base64::decode(entry.salt);
+      plaintext = Encryption::decrypt(data, password);
+      return;
+    }
+    Encryption::Cipher cipher = Encryption::cipherFromName(entry.cipher);
+    decodeField(entry.id, worker.id);
+    decodeField(entry.encryptedPassword, worker.ciphertext);
+    decodeField(entry.iv, worker.scratch);
+    if(worker.scratch.size()!=static_cast<size_t>(Encryption::ivSize(cipher))){
+      throw std::runtime_error("Wrong password or corrupted data");
+    }
+    Encryption::deriveEntryKeyInto(masterKey.data(), masterKey.size(), worker.id.data(), worker.id.size(), worker.key);
+    worker.plaintext.resize(worker.ciphertext.size() + Encryption::BLOCK_SIZE);
+    try{
+      size_t len = worker.session.decryptInto(cipher, worker.key, worker.scratch.data(), worker.id.data(), worker.id.size(),
+                                              worker.ciphertext.data(), worker.ciphertext.size(), worker.plaintext.data(), worker.plaintext.size());
+      plaintext.assign(reinterpret_cast<const char*>(worker.plaintext.data()), len);
+    }catch(...){
+      worker.wipeKey();
+      worker.wipePlaintext();
+      throw;
+    }
+    worker.wipeKey();
+    worker.wipePlaintext();
+  }
+
+  // Decrypts an entry, using the vault key or per-entry PBKDF2 for legacy entries
+  SecureString decryptEntry(const PasswordEntry& entry){
+    if(!entry.id.empty()) unlock();
+    SecureString plaintext;
+    openWithKey(crypto, entry, vaultKey, masterPassword, plaintext);
+    return plaintext;
+  }
+
+  // Decrypts the first entry to confirm the master password; true if it opens or the vault is empty
+  bool verifyOnEntry(){
+    PasswordEntry sample;
+    bool found = false;
+    size_t count = mapped ? mapped->size() : entries.size();
+    for(size_t i=0; i<count && !found; i++){
+      sample = mapped ? mapped->entry(i) : entries[i];
+      found = !sample.id.empty();
+    }
+    if(!found && count>0) sample = mapped ? mapped->entry(0) : entries[0];  // Only legacy entries; one PBKDF2 run
+    else if(!found) return true;
+    SecureString plaintext;
+    try{
+      openWithKey(crypto, sample, vaultKey, masterPassword, plaintext);
+    }catch(const std::exception&){
+      return false;
+    }
+    return true;
+  }
+
+  // Zeroes and drops the cached vault key
+  void clearVaultKey(){
+    OPENSSL_cleanse(vaultKey.data(), vaultKey.size());
+    vaultKey.clear();
+  }
 
   // Gets current timestamp in readable format
-  std::string getCurrentTimestamp(){
+  static std::string getCurrentTimestamp(){
     time_t now = time(0);
     tm *ltm = localtime(&now);
     char buf[80];
@@ -27,7 +533,7 @@ private:
   }
 
   // Escapes special characters for JSON format
-  std::string escapeJson(const std::string& str){
+  static std::string escapeJson(const std::string& str){
     std::string escaped;
     for(char c : str){
       switch(c){
@@ -42,140 +548,892 @@ private:
     return escaped;
   }
 
-  // Unescapes JSON special characters
-  std::string unescapeJson(const std::string& str){
-    std::string unescaped;
-    for(size_t i=0; i<str.length(); i++){
-      if(str[i]=='\\' && i+1<str.length()){
-        switch(str[i+1]){
-          case '"': unescaped += '"'; i++; break;
-          case '\\': unescaped += '\\'; i++; break;
-          case 'n': unescaped += '\n'; i++; break;
-          case 'r': unescaped += '\r'; i++; break;
-          case 't': unescaped += '\t'; i++; break;
-          default: unescaped += str[i];
-        }
+  // Returns the entry field stored under a JSON key, or nullptr for unknown keys
+  static std::string* entryField(PasswordEntry& entry, std::string_view key){
+    if(key=="id") return &entry.id;
+    if(key=="service") return &entry.service;
+    if(key=="username") return &entry.username;
+    if(key=="password") return &entry.encryptedPassword;
+    if(key=="salt") return &entry.salt;
+    if(key=="iv") return &entry.iv;
+    if(key=="cipher") return &entry.cipher;
+    if(key=="timestamp") return &entry.timestamp;
+    if(key=="notes") return &entry.notes;
+    return nullptr;
+  }
+
+  // Reads one entry object straight into its fields
+  static void readEntry(JsonReader& reader, PasswordEntry& entry){
+    reader.beginObject();
+    std::string_view key;
+    while(reader.nextKey(key)){
+      std::string* field = entryField(entry, key);
+      if(field) reader.readString(*field);
+      else reader.skipValue();
+    }
+  }
+
+  // Reads the vault header object with the master key salt and KDF parameters. The KDF fields are 32-bit;
+  // larger values are a corrupt header, not something to wrap into range.
+  void readHeader(JsonReader& reader){
+    reader.beginObject();
+    std::string_view key;
+    std::string value;
+    while(reader.nextKey(key)){
+      if(key=="salt"){
+        reader.readString(value);
+        vaultSalt = Base64::decode(value);
+      }else if(key=="check"){
+        reader.readString(value);
+        vaultKeyCheck = Base64::decode(value);
+      }else if(key=="kdf"){
+        reader.readString(value);
+        vaultKdf.algorithm = Encryption::kdfFromName(value);
+      }else if(key=="iterations"){
+        vaultKdf.iterations = reader.readUnsigned(UINT32_MAX);
+      }else if(key=="memory"){
+        vaultKdf.memoryKiB = reader.readUnsigned(UINT32_MAX);
+      }else if(key=="parallelism"){
+        vaultKdf.parallelism = reader.readUnsigned(UINT32_MAX);
+      }else if(key=="generation"){
+        generation = reader.readUnsigned();
       }else{
-        unescaped += str[i];
+        reader.skipValue();
       }
     }
-    return unescaped;
+  }
+
+  // Reads an array of entry objects
+  void readEntries(JsonReader& reader){
+    STATS_TIMER("json.read_entries");
+    reader.beginArray();
+    while(reader.nextElement()){
+      entries.emplace_back();
+      readEntry(reader, entries.back());
+      STATS_COUNT("json.entries", 1);
+    }
+  }
+
+  // Replays journal records committed since the snapshot was written
+  void replayJournal(){
+    STATS_TIMER("storage.replay_journal");
+    MappedFile journal;
+    if(!journal.open(journalFilename())) return;
+    if(!applyRecords(journal.data(), journal.size(), journalRecords)){
+      snapshotCurrent = false;  // Torn final record; don't append after it, compact on the next commit instead
+    }
+  }
+
+  // Reads the vault file and its journal into this freshly constructed storage, see load(). Returns false
+  // if there is no vault file yet.
+  bool readFiles(){
+    recordStamps();
+    MappedFile file;
+    if(!file.open(filename)) return false;
+    auto binary = std::make_unique<BinaryVault>();
+    if(binary->open(filename)){
+      binaryFormat = true;
+      vaultSalt = binary->getHeader().salt;
+      vaultKeyCheck = binary->getHeader().keyCheck;
+      vaultKdf = binary->getHeader().kdf;
+      generation = binary->getHeader().generation;
+      snapshotCurrent = true;
+      mapped = std::move(binary);
+      struct stat journal;
+      if(::stat(journalFilename().c_str(), &journal)==0 && journal.st_size>0){
+        materialize();  // Journal records apply to the full entry list
+        replayJournal();
+      }
+      return true;
+    }
+    binaryFormat = false;
+    // Single pass over the mapped file, parsing straight into entry fields
+    JsonReader reader(file.data(), file.size());
+    char first = reader.peek();
+    if(first=='['){
+      readEntries(reader);
+    }else if(first=='{'){
+      reader.beginObject();
+      std::string_view key;
+      while(reader.nextKey(key)){
+        if(key=="vault"){
+          readHeader(reader);
+          snapshotCurrent = true;
+        }else if(key=="entries"){
+          readEntries(reader);
+        }else{
+          reader.skipValue();
+        }
+      }
+    }else if(first!=0){
+      throw std::runtime_error("Corrupted vault file: unrecognized format");
+    }
+    rebuildIndex();
+    if(snapshotCurrent) replayJournal();
+    return true;
+  }
+
+  // Swaps in everything readFiles() loaded into fresh. The key is dropped since the header may have changed;
+  // the file lock and cipher contexts stay with this storage.
+  void adoptLoaded(PasswordStorage& fresh){
+    clearVaultKey();
+    std::swap(entries, fresh.entries);
+    std::swap(vaultSalt, fresh.vaultSalt);
+    std::swap(vaultKdf, fresh.vaultKdf);
+    std::swap(vaultKeyCheck, fresh.vaultKeyCheck);
+    std::swap(generation, fresh.generation);
+    std::swap(snapshotCurrent, fresh.snapshotCurrent);
+    std::swap(pendingRecords, fresh.pendingRecords);
+    std::swap(journalRecords, fresh.journalRecords);
+    std::swap(keyIndex, fresh.keyIndex);
+    std::swap(foldedIndex, fresh.foldedIndex);
+    std::swap(idIndex, fresh.idIndex);
+    std::swap(foldedServices, fresh.foldedServices);
+    std::swap(searchIndex, fresh.searchIndex);
+    dropListOrders();
+    std::swap(binaryFormat, fresh.binaryFormat);
+    std::swap(mapped, fresh.mapped);
+    std::swap(vaultStamp, fresh.vaultStamp);
+    std::swap(journalStamp, fresh.journalStamp);
+  }
+
+  // Applies newline-terminated journal records of the current generation, counting them in applied.
+  // Returns false if the text ends in a partial record.
+  bool applyRecords(const char* data, size_t size, size_t& applied){
+    size_t start = 0;
+    PasswordEntry record;
+    std::string op;
+    while(start<size){
+      const char* newline = static_cast<const char*>(std::memchr(data+start, '\n', size-start));
+      if(!newline) return false;
+      JsonReader reader(data+start, newline-(data+start));
+      start = newline-data+1;
+      record = PasswordEntry();
+      unsigned long gen = 0;
+      reader.beginObject();
+      std::string_view key;
+      while(reader.nextKey(key)){
+        std::string* field = entryField(record, key);
+        if(field) reader.readString(*field);
+        else if(key=="op") reader.readString(op);
+        else if(key=="gen") gen = reader.readUnsigned();
+        else reader.skipValue();
+      }
+      if(gen!=generation) continue;
+      if(op=="add"){
+        entries.push_back(record);
+        indexAppended();
+      }else if(op=="update"){
+        replaceById(record);
+      }else if(op=="delete"){
+        removeMatching(record.service, record.username);
+      }
+      applied++;
+    }
+    return true;
+  }
+
+  static bool sameKdf(const Encryption::KdfParams& a, const Encryption::KdfParams& b){
+    return a.algorithm==b.algorithm && a.iterations==b.iterations && a.memoryKiB==b.memoryKiB && a.parallelism==b.parallelism;
+  }
+
+  // Takes the key previous derived, if it was derived for the header this storage has loaded
+  bool reuseKey(const PasswordStorage& previous){
+    if(previous.vaultKey.empty() || previous.vaultSalt!=vaultSalt || previous.vaultKeyCheck!=vaultKeyCheck || !sameKdf(previous.vaultKdf, vaultKdf)){
+      return false;
+    }
+    vaultKey = previous.vaultKey;
+    return true;
+  }
+
+  std::string lockFilename() const{
+    return filename+".lock";
+  }
+
+  void recordStamps(){
+    vaultStamp = DurableFile::stamp(filename);
+    journalStamp = DurableFile::stamp(journalFilename());
+  }
+
+  // Holds the file lock for a scope, reusing one the storage already holds
+  class FileLockScope{
+  private:
+    PasswordStorage& storage;
+
+  public:
+    FileLockScope(PasswordStorage& owner, bool exclusive) : storage(owner){
+      storage.lockFile(exclusive);
+    }
+
+    ~FileLockScope(){
+      storage.unlockFile();
+    }
+  };
+
+  // Re-reads a vault another process changed, then re-applies this storage's uncommitted records on top
+  // so both sets of changes survive. Records encrypted under a key the vault no longer uses can't be
+  // carried over; that throws and leaves them pending.
+  void mergeFromDisk(){
+    STATS_TIMER("storage.merge");
+    PasswordStorage previous(filename, masterPassword);
+    previous.vaultKey = vaultKey;
+    previous.vaultSalt = vaultSalt;
+    previous.vaultKeyCheck = vaultKeyCheck;
+    previous.vaultKdf = vaultKdf;
+    std::vector<std::string> pending = std::move(pendingRecords);
+    bool unlocked = !vaultKey.empty();
+    try{
+      load();
+      if(unlocked && !reuseKey(previous)){
+        if(!pending.empty()) throw std::runtime_error("The vault was re-keyed by another process; uncommitted changes can't be merged");
+        unlock();
+      }
+    }catch(...){
+      pendingRecords = std::move(pending);
+      throw;
+    }
+    std::string text = journalText(pending);
+    size_t applied = 0;
+    materialize();
+    applyRecords(text.data(), text.size(), applied);
+    pendingRecords = std::move(pending);
   }
 
 public:
-  PasswordStorage(const std::string& file, const std::string& master) : filename(file), masterPassword(master){}
+  PasswordStorage(const std::string& file, std::string_view master) : filename(file), masterPassword(master), binaryFormat(hasBinaryExtension(file)){}
+
+  ~PasswordStorage(){
+    clearVaultKey();
+  }
+
+  // Takes the cross-process lock on the vault, a flock on <vault>.lock, unless this storage already holds
+  // it. commit() and save() lock for themselves; holding the lock from a refresh() through a commit()
+  // makes the read-modify-write atomic against other processes. Calls nest; each needs an unlockFile().
+  void lockFile(bool exclusive=true){
+    if(fileLockDepth==0) fileLock = std::make_unique<DurableFile::FileLock>(lockFilename(), exclusive);
+    fileLockDepth++;
+  }
+
+  void unlockFile(){
+    if(fileLockDepth>0 && --fileLockDepth==0) fileLock.reset();
+  }
+
+  // True if the vault or its journal changed on disk since this storage last read or wrote them
+  bool changedOnDisk() const{
+    return DurableFile::stamp(filename)!=vaultStamp || DurableFile::stamp(journalFilename())!=journalStamp;
+  }
+
+  // Picks up changes other processes made to the file, keeping the derived key when the header still
+  // matches so no key derivation runs. Uncommitted changes are re-applied on top. Returns true if it reloaded.
+  bool refresh(){
+    if(!changedOnDisk()) return false;
+    mergeFromDisk();
+    return true;
+  }
+
+  // Continues from previous, an older view of the same vault: reuses its key when the header is unchanged
+  // (deriving one otherwise) and takes over the file lock it holds. For loading a fresh copy off to the side.
+  void takeOver(PasswordStorage& previous){
+    if(!previous.vaultKey.empty() && !reuseKey(previous)) unlock();
+    fileLock = std::move(previous.fileLock);
+    fileLockDepth = previous.fileLockDepth;
+    previous.fileLockDepth = 0;
+  }
+
+  // Derives the vault master key once and checks it against the header, throwing on a wrong master password.
+  // The key stays cached for the session; per-entry keys are then cheap HKDF expansions.
+  void unlock(){
+    if(!vaultKey.empty()) return;
+    if(vaultSalt.empty()){
+      vaultSalt = Encryption::randomBytes(Encryption::SALT_SIZE);  // New vault
+    }
+    vaultKey = Encryption::deriveMasterKey(masterPassword, vaultSalt, vaultKdf);
+    auto check = Encryption::keyCheck(vaultKey);
+    if(vaultKeyCheck.empty()){
+      // Vault written without a check value: confirm the password on one entry, then record one for the next save
+      if(!verifyOnEntry()){
+        clearVaultKey();
+        throw std::runtime_error("Wrong master password");
+      }
+      vaultKeyCheck = check;
+      snapshotCurrent = false;
+    }else if(!Encryption::keyCheckMatches(check, vaultKeyCheck)){
+      clearVaultKey();
+      throw std::runtime_error("Wrong master password");
+    }
+  }
+
+  // Unlocks with a new master password, e.g. after lock(); throws and stays locked if it is wrong
+  void unlock(std::string_view password){
+    lock();
+    masterPassword = password;
+    try{
+      unlock();
+    }catch(...){
+      lock();
+      throw;
+    }
+  }
+
+  // Forgets the master password and vault key. Entries stay loaded, but nothing can be decrypted or
+  // encrypted until unlock(password) succeeds.
+  void lock(){
+    clearVaultKey();
+    masterPassword.wipe();
+  }
+
+  bool isLocked() const{
+    return vaultKey.empty();
+  }
 
   // Adds a new encrypted password entry
-  void addEntry(const std::string& service, const std::string& username, const std::string& password, const std::string& notes=""){
-    auto encrypted = Encryption::encrypt(password, masterPassword);
+  void addEntry(const std::string& service, const std::string& username, std::string_view password, const std::string& notes=""){
+    materialize();
     PasswordEntry entry;
     entry.service = service;
     entry.username = username;
-    entry.encryptedPassword = Base64::encode(encrypted.ciphertext);
-    entry.salt = Base64::encode(encrypted.salt);
-    entry.iv = Base64::encode(encrypted.iv);
+    encryptInto(entry, password);
     entry.timestamp = getCurrentTimestamp();
     entry.notes = notes;
     entries.push_back(entry);
+    indexAppended();
+    journalEntry("add", entry);
+  }
+
+  // Encrypts a new entry without adding it. Safe to call concurrently once unlock() has run,
+  // as long as each thread passes its own worker.
+  PasswordEntry encryptEntry(CryptoWorker& worker, const std::string& service, const std::string& username, std::string_view password, const std::string& notes="") const{
+    PasswordEntry entry;
+    entry.service = service;
+    entry.username = username;
+    entry.notes = notes;
+    sealInto(worker, entry, password);
+    return entry;
+  }
+
+  PasswordEntry encryptEntry(const std::string& service, const std::string& username, std::string_view password, const std::string& notes="") const{
+    CryptoWorker worker;
+    return encryptEntry(worker, service, username, password, notes);
   }
 
-  // Retrieves and decrypts a password
-  std::string getPassword(const std::string& service, const std::string& username=""){
-    for(const auto& entry : entries){
-      if(entry.service==service && (username.empty() || entry.username==username)){
-        Encryption::EncryptedData data;
-        data.ciphertext = Base64::decode(entry.encryptedPassword);
-        data.salt = Base64::decode(entry.salt);
-        data.iv = Base64::decode(entry.iv);
-        return Encryption::decrypt(data, masterPassword);
+  // Adds already encrypted entries, stamping them and queueing journal records; commit() writes them in one go
+  void addEntries(std::vector<PasswordEntry>& batch){
+    materialize();
+    std::string timestamp = getCurrentTimestamp();
+    entries.reserve(entries.size()+batch.size());
+    for(auto& entry : batch){
+      if(entry.timestamp.empty()) entry.timestamp = timestamp;
+      entries.push_back(std::move(entry));
+      indexAppended();
+      journalEntry("add", entries.back());
+    }
+    batch.clear();
+  }
+
+  // Re-encrypts the password of the first entry matching service and optional username
+  bool updateEntry(const std::string& service, const std::string& username, std::string_view password){
+    materialize();
+    auto positions = findExact(service, username);
+    if(positions.empty()) return false;
+    size_t pos = positions.front();
+    PasswordEntry updated = entries[pos];
+    bool legacy = updated.id.empty();
+    encryptInto(updated, password);
+    updated.timestamp = getCurrentTimestamp();
+    unindexEntry(pos);
+    entries[pos] = updated;
+    indexEntry(pos);
+    if(legacy){
+      snapshotCurrent = false;  // No ID to key a journal record on, next commit rewrites the snapshot
+    }else{
+      journalEntry("update", updated);
+    }
+    return true;
+  }
+
+  // Retrieves and decrypts a password, falling back to a case-insensitive match
+  SecureString getPassword(const std::string& service, const std::string& username=""){
+    unlock();
+    return getPassword(crypto, service, username);
+  }
+
+  // Lookup and decryption with the caller's worker. Read-only, so threads may call it concurrently with
+  // their own workers once unlock() has run.
+  SecureString getPassword(CryptoWorker& worker, const std::string& service, const std::string& username="") const{
+    STATS_TIMER("storage.get_password");
+    requireUnlocked();
+    PasswordEntry copy;
+    const PasswordEntry* entry;
+    if(mapped){
+      size_t index;
+      if(!findMapped(service, username, index)){
+        throw std::runtime_error("No matching entry found");
+      }
+      copy = mapped->entry(index);  // Touches only this record
+      entry = &copy;
+    }else{
+      auto positions = findExact(service, username);
+      if(positions.empty()) positions = findFolded(service, username);
+      if(positions.empty()){
+        throw std::runtime_error("No matching entry found");
+      }
+      entry = &entries[positions.front()];
+    }
+    SecureString password;
+    openWithKey(worker, *entry, vaultKey, masterPassword, password);
+    return password;
+  }
+
+  // Returns entries matching service and optional username ignoring case
+  std::vector<PasswordEntry> findEntries(const std::string& service, const std::string& username="") const{
+    std::vector<PasswordEntry> found;
+    if(mapped){
+      std::string foldedUser = foldCase(username);
+      for(size_t i : mapped->findService(service)){
+        auto entry = mapped->entry(i);
+        if(username.empty() || foldCase(entry.username)==foldedUser) found.push_back(entry);
       }
+      return found;
+    }
+    for(size_t pos : findFolded(service, username)) found.push_back(entries[pos]);
+    return found;
+  }
+
+  // Returns entries whose service starts with prefix ignoring case
+  std::vector<PasswordEntry> findByPrefix(const std::string& prefix){
+    materialize();
+    std::vector<PasswordEntry> found;
+    std::string folded = foldCase(prefix);
+    for(auto it=foldedServices.lower_bound(folded); it!=foldedServices.end() && it->compare(0, folded.size(), folded)==0; ++it){
+      for(size_t pos : foldedIndex.at(*it)) found.push_back(entries[pos]);
+    }
+    return found;
+  }
+
+  // An entry returned by search(); the password stays encrypted
+  struct SearchResult{
+    PasswordEntry entry;
+    double score;
+    SearchIndex::Field field;
+  };
+
+  // Returns up to limit entries whose service, username or notes best resemble query, most similar first.
+  // Uses only the trigram index, so nothing is decrypted and the vault needn't be unlocked.
+  std::vector<SearchResult> search(std::string_view query, size_t limit=10){
+    buildSearchIndex();
+    return findSimilar(query, limit);
+  }
+
+  // Builds the search index of a mapped binary vault now rather than on the first search
+  void buildSearchIndex(){
+    if(!mapped || searchIndex.size()==mapped->size()) return;
+    searchIndex.clear();
+    searchIndex.reserve(mapped->size());
+    for(size_t i=0; i<mapped->size(); i++){
+      auto rec = mapped->record(i);
+      searchIndex.add(rec.service, rec.username, rec.notes);
+    }
+  }
+
+  // Copies every record out of a lazily mapped binary vault so entries can be modified.
+  // Mutations do this themselves; calling it up front moves the cost out of the first one.
+  void materialize(){
+    if(!mapped) return;
+    STATS_TIMER("storage.materialize");
+    entries.reserve(mapped->size());
+    for(size_t i=0; i<mapped->size(); i++) entries.push_back(mapped->entry(i));
+    mapped.reset();
+    rebuildIndex();
+  }
+
+  // search() for an index already built; read-only, so concurrent readers may call it
+  std::vector<SearchResult> findSimilar(std::string_view query, size_t limit=10) const{
+    STATS_TIMER("storage.search");
+    std::vector<SearchResult> results;
+    for(const auto& hit : searchIndex.search(query, limit)){
+      results.push_back({mapped ? mapped->entry(hit.position) : entries[hit.position], hit.score, hit.field});
+    }
+    return results;
+  }
+
+  // Decrypts the password of an entry returned by listEntries or findEntries
+  SecureString decryptPassword(const PasswordEntry& entry){
+    return decryptEntry(entry);
+  }
+
+  // Decrypts the entries at positions [begin, end), calling fn(entry, password) for each and wiping the
+  // password afterwards. Read-only, so threads may call it concurrently with their own workers once
+  // unlock() has run; binary vault records are decoded one at a time instead of being materialized.
+  template<typename Fn>
+  void openEntries(CryptoWorker& worker, size_t begin, size_t end, Fn fn) const{
+    requireUnlocked();
+    SecureString password;
+    PasswordEntry copy;
+    for(size_t i=begin; i<end; i++){
+      if(mapped) copy = mapped->entry(i);
+      const PasswordEntry& entry = mapped ? copy : entries[i];
+      openWithKey(worker, entry, vaultKey, masterPassword, password);
+      fn(entry, password);
+      password.wipe();
     }
-    throw std::runtime_error("No matching entry found");
   }
 
   // Returns all stored entries without decrypting passwords
-  std::vector<PasswordEntry> listEntries() const{
+  // Copies every entry, ciphertext included; listPage() shows entries without copying them
+  std::vector<PasswordEntry> listEntries(){
+    materialize();
     return entries;
   }
 
+  // Calls fn(const EntryMeta&) for the query's page of entries and returns how many entries match in all.
+  // Nothing is copied or decrypted, and mapped binary vaults stay mapped. Sorting is done on the first
+  // listing in each order after a change; later pages cost O(limit), plus O(log n) for a service prefix
+  // in BY_SERVICE order. A prefix in other orders scans the vault.
+  template<typename Fn>
+  size_t listPage(const ListQuery& query, Fn fn){
+    STATS_TIMER("storage.list_page");
+    size_t count = getEntryCount();
+    const uint32_t* order = nullptr;
+    if(query.order!=BY_POSITION) order = listOrder(query.order).data();
+    auto positionAt = [&](size_t i){ return order ? order[i] : i; };
+    std::string_view prefix = query.servicePrefix;
+    auto matches = [&](size_t pos){
+      return compareFolded(metaAt(pos).service.substr(0, prefix.size()), prefix)==0;
+    };
+    size_t begin = 0, end = count;
+    if(!prefix.empty() && query.order==BY_SERVICE){
+      auto below = [&](uint32_t pos, std::string_view p){ return compareFolded(metaAt(pos).service.substr(0, p.size()), p)<0; };
+      auto above = [&](std::string_view p, uint32_t pos){ return compareFolded(p, metaAt(pos).service.substr(0, p.size()))<0; };
+      begin = std::lower_bound(order, order+count, prefix, below)-order;
+      end = std::upper_bound(order+begin, order+count, prefix, above)-order;
+    }else if(!prefix.empty()){
+      // Matches are spread through the order: walk it, skipping offset matches
+      size_t matched = 0;
+      for(size_t i=0; i<count; i++){
+        size_t pos = positionAt(query.descending ? count-1-i : i);
+        if(!matches(pos)) continue;
+        if(matched>=query.offset && matched-query.offset<query.limit) fn(metaAt(pos));
+        matched++;
+      }
+      return matched;
+    }
+    size_t total = end-begin;
+    if(query.offset>=total) return total;
+    size_t n = std::min(query.limit, total-query.offset);
+    for(size_t i=query.offset; i<query.offset+n; i++){
+      fn(metaAt(positionAt(query.descending ? end-1-i : begin+i)));
+    }
+    return total;
+  }
+
   // Deletes an entry matching service and optional username
   bool deleteEntry(const std::string& service, const std::string& username=""){
-    auto it = std::remove_if(entries.begin(), entries.end(), [&](const PasswordEntry& e){
-      return e.service==service && (username.empty() || e.username==username);
+    materialize();
+    if(!removeMatching(service, username)) return false;
+    pendingRecords.push_back(deleteRecord(service, username));
+    return true;
+  }
+
+  // Staged changes, for writers that must not change the storage while it is being read (see SharedStorage):
+  // the stage*() functions build the journal record of a change without applying it, appendStaged() makes
+  // records durable, and applyStaged() applies them in memory, which is all that needs readers kept out.
+
+  std::string stageAdd(CryptoWorker& worker, const std::string& service, const std::string& username, std::string_view password, const std::string& notes="") const{
+    PasswordEntry entry = encryptEntry(worker, service, username, password, notes);
+    entry.timestamp = getCurrentTimestamp();
+    return entryRecord("add", entry);
+  }
+
+  // False if no entry matches, like updateEntry()
+  bool stageUpdate(CryptoWorker& worker, const std::string& service, const std::string& username, std::string_view password, std::string& record) const{
+    PasswordEntry updated;
+    if(!exactEntry(service, username, updated)) return false;
+    if(updated.id.empty()){
+      throw std::runtime_error("Entry predates vault keys; open the vault once to migrate it");
+    }
+    sealInto(worker, updated, password);
+    updated.timestamp = getCurrentTimestamp();
+    record = entryRecord("update", updated);
+    return true;
+  }
+
+  // False if no entry matches, like deleteEntry()
+  bool stageDelete(const std::string& service, const std::string& username, std::string& record) const{
+    PasswordEntry found;
+    if(!exactEntry(service, username, found)) return false;
+    record = deleteRecord(service, username);
+    return true;
+  }
+
+  // Appends staged records to the journal with one fsync'd write, without applying them. The caller holds
+  // the file lock and has refreshed. Returns false, writing nothing, if the file on disk isn't a snapshot
+  // the journal can extend; applyStaged() then queues the records for the next commit() to snapshot.
+  bool appendStaged(const std::vector<std::string>& records){
+    FileLockScope lock(*this, true);
+    if(!snapshotCurrent) return false;
+    DurableFile::appendDurable(journalFilename(), journalText(records));
+    journalRecords += records.size();
+    journalStamp = DurableFile::stamp(journalFilename());
+    return true;
+  }
+
+  void applyStaged(const std::vector<std::string>& records, bool appended){
+    materialize();
+    std::string text = journalText(records);
+    size_t applied = 0;
+    applyRecords(text.data(), text.size(), applied);
+    if(!appended) pendingRecords.insert(pendingRecords.end(), records.begin(), records.end());
+  }
+
+  // Returns the number of entries still encrypted with per-entry PBKDF2 keys
+  int getLegacyEntryCount() const{
+    if(mapped) return mapped->getHeader().legacyCount;
+    return std::count_if(entries.begin(), entries.end(), [](const PasswordEntry& e){ return e.id.empty(); });
+  }
+
+  // Re-encrypts legacy entries under the vault key; call save() afterwards to persist
+  int migrateLegacyEntries(){
+    materialize();
+    std::vector<PasswordEntry> migrated = entries;
+    int count = 0;
+    for(auto& entry : migrated){
+      if(!entry.id.empty()) continue;
+      SecureString password = decryptEntry(entry);
+      encryptInto(entry, password);
+      count++;
+    }
+    entries.swap(migrated);  // Only replace entries once every legacy entry decrypted
+    rebuildIndex();
+    return count;
+  }
+
+  // Changes the master password: every entry is decrypted and re-encrypted under a new vault key across
+  // threads workers (0 = one per core), then the vault is rewritten atomically. On any failure the
+  // file and the in-memory vault keep the old key. progress(done, total) is called after each chunk.
+  void rekey(std::string_view newMaster, unsigned threads=0, std::function<void(size_t, size_t)> progress=nullptr){
+    rekey(newMaster, vaultKdf, threads, progress);
+  }
+
+  // Rekeys with new KDF parameters as well, e.g. ones picked by Encryption::calibrate
+  void rekey(std::string_view newMaster, const Encryption::KdfParams& kdf, unsigned threads=0, std::function<void(size_t, size_t)> progress=nullptr){
+    unlock();
+    materialize();
+    auto newSalt = Encryption::randomBytes(Encryption::SALT_SIZE);
+    auto newKey = Encryption::deriveMasterKey(newMaster, newSalt, kdf);
+    Encryption::KdfParams newKdf = kdf;
+    auto newCheck = Encryption::keyCheck(newKey);
+    std::vector<PasswordEntry> rekeyed(entries);
+    std::atomic<size_t> done(0);
+    std::mutex progressMutex;
+    if(threads==0) threads = Parallel::defaultThreads();
+    std::vector<std::unique_ptr<CryptoWorker>> workers;
+    for(unsigned i=0; i<threads; i++) workers.emplace_back(new CryptoWorker());
+    Parallel::forChunks(rekeyed.size(), threads, 256, [&](unsigned w, size_t begin, size_t end){
+      CryptoWorker& worker = *workers[w];
+      SecureString password;
+      for(size_t i=begin; i<end; i++){
+        openWithKey(worker, rekeyed[i], vaultKey, masterPassword, password);
+        sealWithKey(worker, rekeyed[i], password, newKey);
+        password.wipe();
+      }
+      size_t finished = done += end-begin;
+      if(progress){
+        std::lock_guard<std::mutex> lock(progressMutex);
+        progress(finished, rekeyed.size());
+      }
     });
-    if(it!=entries.end()){
-      entries.erase(it, entries.end());
-      return true;
+    // Swap the new key material in, write it out, and swap back if the write fails. Each new* variable
+    // then holds the old value it replaced, ready for the rollback.
+    SecureString newPassword(newMaster);
+    entries.swap(rekeyed);
+    vaultSalt.swap(newSalt);
+    vaultKey.swap(newKey);
+    vaultKeyCheck.swap(newCheck);
+    std::swap(vaultKdf, newKdf);
+    masterPassword.swap(newPassword);
+    try{
+      save();
+    }catch(...){
+      entries.swap(rekeyed);
+      vaultSalt.swap(newSalt);
+      vaultKey.swap(newKey);
+      vaultKeyCheck.swap(newCheck);
+      std::swap(vaultKdf, newKdf);
+      masterPassword.swap(newPassword);
+      throw;
     }
-    return false;
+    rebuildIndex();  // newKey and newPassword hold the old key and master password, zeroed on destruction
+  }
+
+  // Keeps the master password but re-derives the vault key with new KDF parameters, rekeying every entry
+  void changeKdf(const Encryption::KdfParams& kdf, unsigned threads=0, std::function<void(size_t, size_t)> progress=nullptr){
+    rekey(masterPassword, kdf, threads, progress);
+  }
+
+  // Decrypts every entry across threads workers (0 = one per core), scores it with the strength estimator
+  // and flags entries scoring below minScore or sharing a password with another entry. Reuse is found by
+  // sorting keyed fingerprints under a key drawn for this audit only, so no plaintexts are compared or kept.
+  AuditReport audit(int minScore=50, unsigned threads=0){
+    STATS_TIMER("storage.audit");
+    auto start = std::chrono::steady_clock::now();
+    unlock();
+    size_t count = mapped ? mapped->size() : entries.size();
+    SecureBytes auditKey(Encryption::KEY_SIZE);
+    Encryption::randomInto(auditKey.data(), auditKey.size());
+    struct Scan{
+      unsigned char fingerprint[Encryption::FINGERPRINT_SIZE];
+      StrengthEstimator::Estimate estimate;
+      bool readable = false;
+    };
+    std::vector<Scan> scans(count);
+    if(threads==0) threads = Parallel::defaultThreads();
+    std::vector<std::unique_ptr<CryptoWorker>> workers;
+    for(unsigned i=0; i<threads; i++) workers.emplace_back(new CryptoWorker());
+    const StrengthEstimator& estimator = StrengthEstimator::instance();
+    Parallel::forChunks(count, threads, 256, [&](unsigned w, size_t begin, size_t end){
+      CryptoWorker& worker = *workers[w];
+      SecureString password;
+      PasswordEntry copy;
+      for(size_t i=begin; i<end; i++){
+        if(mapped) copy = mapped->entry(i);
+        const PasswordEntry& entry = mapped ? copy : entries[i];
+        try{
+          openWithKey(worker, entry, vaultKey, masterPassword, password);
+        }catch(const std::exception&){
+          continue;  // Reported as unreadable
+        }
+        scans[i].estimate = estimator.estimate(password);
+        Encryption::fingerprintInto(auditKey, password.data(), password.size(), scans[i].fingerprint);
+        scans[i].readable = true;
+        password.wipe();
+      }
+    });
+    // Group equal fingerprints
+    std::vector<size_t> order;
+    order.reserve(count);
+    for(size_t i=0; i<count; i++) if(scans[i].readable) order.push_back(i);
+    auto less = [&](size_t a, size_t b){ return std::memcmp(scans[a].fingerprint, scans[b].fingerprint, Encryption::FINGERPRINT_SIZE)<0; };
+    std::sort(order.begin(), order.end(), less);
+    std::vector<size_t> groupOf(count, 0), groupSize(1, 0);
+    for(size_t k=0; k<order.size();){
+      size_t run = k+1;
+      while(run<order.size() && !less(order[k], order[run])) run++;
+      if(run-k>1){
+        groupSize.push_back(run-k);
+        for(size_t m=k; m<run; m++) groupOf[order[m]] = groupSize.size()-1;
+      }
+      k = run;
+    }
+    AuditReport report;
+    report.scanned = count;
+    report.reuseGroups = groupSize.size()-1;
+    for(size_t i=0; i<count; i++){
+      const Scan& scan = scans[i];
+      bool weak = scan.readable && scan.estimate.score<minScore;
+      bool reused = groupOf[i]!=0;
+      if(!scan.readable) report.unreadable++;
+      if(weak) report.weak++;
+      if(reused) report.reused++;
+      if(scan.readable && !weak && !reused) continue;
+      AuditFinding finding;
+      if(mapped){
+        auto rec = mapped->record(i);
+        finding.service = std::string(rec.service);
+        finding.username = std::string(rec.username);
+      }else{
+        finding.service = entries[i].service;
+        finding.username = entries[i].username;
+      }
+      finding.score = scan.readable ? scan.estimate.score : -1;
+      finding.bits = scan.estimate.bits;
+      finding.weakest = scan.estimate.weakest;
+      finding.reuseGroup = groupOf[i];
+      finding.reuseCount = reused ? groupSize[groupOf[i]] : 1;
+      report.findings.push_back(std::move(finding));
+    }
+    std::sort(report.findings.begin(), report.findings.end(), [](const AuditFinding& a, const AuditFinding& b){
+      return a.service!=b.service ? a.service<b.service : a.username<b.username;
+    });
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return report;
   }
 
-  // Saves all entries to JSON file
+  // Appends pending add/delete/update records to the journal with one fsync'd write.
+  // Falls back to a full snapshot when the file isn't in the current format or the journal has grown large.
+  // Takes the file lock, first merging in whatever other processes committed since this storage last looked.
+  void commit(){
+    STATS_TIMER("storage.commit");
+    FileLockScope lock(*this, true);
+    refresh();
+    if(!snapshotCurrent || journalRecords+pendingRecords.size()>std::max(static_cast<size_t>(JOURNAL_COMPACT_MIN), entries.size())){
+      save();
+      return;
+    }
+    if(pendingRecords.empty()) return;
+    DurableFile::appendDurable(journalFilename(), journalText(pendingRecords));
+    journalRecords += pendingRecords.size();
+    pendingRecords.clear();
+    journalStamp = DurableFile::stamp(journalFilename());
+  }
+
+  // Writes a full snapshot atomically (temp file, fsync, rename) and discards the journal. Throws instead of
+  // overwriting if another process changed the vault since this storage read it; refresh() first to merge.
   void save(){
-    std::ofstream file(filename);
-    if(!file.is_open()){
-      throw std::runtime_error("Can't open file for writing");
+    STATS_TIMER("storage.save");
+    FileLockScope lock(*this, true);
+    if(changedOnDisk()){
+      throw std::runtime_error("The vault was changed by another process; reload it and try again");
     }
-    file<<"[\n";
-    for(size_t i=0; i<entries.size(); i++){
-      const auto& e = entries[i];
-      file<<"  {\n";
-      file<<"    \"service\": \""<<escapeJson(e.service)<<"\",\n";
-      file<<"    \"username\": \""<<escapeJson(e.username)<<"\",\n";
-      file<<"    \"password\": \""<<escapeJson(e.encryptedPassword)<<"\",\n";
-      file<<"    \"salt\": \""<<escapeJson(e.salt)<<"\",\n";
-      file<<"    \"iv\": \""<<escapeJson(e.iv)<<"\",\n";
-      file<<"    \"timestamp\": \""<<escapeJson(e.timestamp)<<"\",\n";
-      file<<"    \"notes\": \""<<escapeJson(e.notes)<<"\"\n";
-      file<<"  }"<<(i<entries.size()-1 ? "," : "")<<"\n";
-    }
-    file<<"]\n";
-    file.close();
-  }
-
-  // Loads entries from JSON file
+    unlock();
+    materialize();
+    generation++;
+    try{
+      writeSnapshot(filename, binaryFormat);
+    }catch(...){
+      generation--;  // Journal records must keep matching the snapshot still on disk
+      throw;
+    }
+    DurableFile::remove(journalFilename());  // Stale records are also ignored by generation
+    recordStamps();
+    snapshotCurrent = true;
+    pendingRecords.clear();
+    journalRecords = 0;
+  }
+
+  // Writes a copy of the vault to path, as a binary vault if it ends in .pvault and JSON otherwise
+  void saveAs(const std::string& path){
+    unlock();
+    materialize();
+    writeSnapshot(path, hasBinaryExtension(path));
+    DurableFile::remove(path+".journal");
+  }
+
+  const Encryption::KdfParams& getKdf() const{
+    return vaultKdf;
+  }
+
+  bool isBinary() const{
+    return binaryFormat;
+  }
+
+  // Loads the vault from a binary vault or JSON file (legacy files are a bare entry array).
+  // Binary vaults stay mapped and are only copied into entries when modified or listed.
+  // The files are stamped before reading, so a change landing mid-read still shows in changedOnDisk().
+  // They are read into a separate storage and swapped in once fully parsed, so a corrupt vault or journal
+  // throws and leaves this storage as it was.
   void load(){
-    std::ifstream file(filename);
-    if(!file.is_open()){
-      return;  // File doesn't exist yet, that's okay
-    }
-    entries.clear();
-    std::string line, content;
-    while(std::getline(file, line)){
-      content += line;
-    }
-    file.close();
-    // Simple JSON parser - extracts objects between { }
-    size_t pos = 0;
-    while((pos=content.find("{", pos))!=std::string::npos){
-      size_t end = content.find("}", pos);
-      if(end==std::string::npos) break;
-      PasswordEntry entry;
-      std::string block = content.substr(pos, end-pos+1);
-      // Lambda to extract value for a given key
-      auto extract = [&](const std::string& key) -> std::string{
-        std::string search = "\""+key+"\":";
-        size_t start = block.find(search);
-        if(start==std::string::npos) return "";
-        start = block.find("\"", start+search.length());
-        if(start==std::string::npos) return "";
-        size_t finish = block.find("\"", start+1);
-        if(finish==std::string::npos) return "";
-        return unescapeJson(block.substr(start+1, finish-start-1));
-      };
-      entry.service = extract("service");
-      entry.username = extract("username");
-      entry.encryptedPassword = extract("password");
-      entry.salt = extract("salt");
-      entry.iv = extract("iv");
-      entry.timestamp = extract("timestamp");
-      entry.notes = extract("notes");
-      entries.push_back(entry);
-      pos = end+1;
+    STATS_TIMER("storage.load");
+    PasswordStorage fresh(filename, masterPassword);
+    if(!fresh.readFiles()){
+      vaultStamp = fresh.vaultStamp;  // File doesn't exist yet, that's okay
+      journalStamp = fresh.journalStamp;
+      return;
     }
+    adoptLoaded(fresh);
   }
 
   int getEntryCount() const{
+    if(mapped) return mapped->size();
     return entries.size();
   }
 };
@@ -0,0 +1,254 @@
+// search_index.h
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+#include<string_view>
+#include<vector>
+#include<unordered_map>
+#include<algorithm>
+#include<cstdint>
+#include<cctype>
+
+// Inverted trigram index over the service, username and notes of each entry, addressed by entry position.
+// Each field is lowercased and padded (so prefixes get their own trigrams), and a query is ranked by the
+// Jaccard similarity of its trigram set against each field, weighted towards service. Only plaintext
+// metadata is indexed; passwords never pass through here.
+class SearchIndex{
+public:
+  enum Field{SERVICE, USERNAME, NOTES};
+  static const int FIELDS = 3;
+  static constexpr size_t MAX_FIELD = 256;   // Characters of a field indexed; long notes are cut
+  static constexpr size_t MAX_QUERY = 64;    // Characters of a query used
+  static constexpr double MIN_SCORE = 0.1;   // Hits scoring lower are dropped
+  static constexpr size_t PROBE_COST = 128;  // Posting entries scanned in the time one candidate's keys are probed
+
+  struct Hit{
+    size_t position;
+    double score;   // Weighted similarity in (0, 1]
+    Field field;    // Best matching field
+  };
+
+  static const char* fieldName(Field field){
+    static const char* const names[] = {"service", "username", "notes"};
+    return names[field];
+  }
+
+private:
+  static constexpr char PAD = '\x01';
+  static constexpr double WEIGHTS[FIELDS] = {1.0, 0.85, 0.7};
+
+  // Per-entry trigram keys (trigram | field<<24, sorted) and each key's slot in its posting list,
+  // so an entry leaves every list in O(1)
+  struct Doc{
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> slots;
+  };
+
+  // Distinct trigrams per field of an entry, kept apart from Doc so ranking reads them sequentially
+  struct FieldSizes{
+    uint16_t count[FIELDS];
+  };
+
+  // A query key and its posting list
+  struct Term{
+    uint32_t key;
+    const std::vector<uint32_t>* list;
+  };
+
+  std::unordered_map<uint32_t, std::vector<uint32_t>> postings;  // Key -> entry positions
+  std::vector<Doc> docs;
+  std::vector<FieldSizes> sizes;  // By position, like docs
+
+  static bool better(const Hit& a, const Hit& b){
+    return a.score!=b.score ? a.score>b.score : a.position<b.position;
+  }
+
+  // Keeps the best limit touched entries in hits, a heap with the worst hit in front. Scores are final:
+  // counts from the scanned lists plus the keys of terms[from..] found by merging with each entry's keys.
+  void score(const std::vector<uint32_t>& touched, const std::vector<uint8_t>& shared, const std::vector<Term>& terms,
+             size_t from, double q, size_t limit, std::vector<Hit>& hits) const{
+    hits.clear();
+    std::vector<uint32_t> rest;
+    for(size_t t=from; t<terms.size(); t++) rest.push_back(terms[t].key);
+    std::sort(rest.begin(), rest.end());
+    for(uint32_t pos : touched){
+      int counts[FIELDS];
+      for(int f=0; f<FIELDS; f++) counts[f] = shared[static_cast<size_t>(pos)*FIELDS+f];
+      if(!rest.empty()){
+        const auto& keys = docs[pos].keys;
+        size_t i = 0, j = 0;
+        while(i<keys.size() && j<rest.size()){
+          if(keys[i]<rest[j]){
+            i++;
+          }else if(rest[j]<keys[i]){
+            j++;
+          }else{
+            counts[keys[i]>>24]++;
+            i++;
+            j++;
+          }
+        }
+      }
+      const FieldSizes& size = sizes[pos];
+      Hit best{pos, 0, SERVICE};
+      for(int f=0; f<FIELDS; f++){
+        if(!counts[f]) continue;
+        double s = WEIGHTS[f]*counts[f]/(q+size.count[f]-counts[f]);
+        if(s>best.score) best = Hit{pos, s, static_cast<Field>(f)};
+      }
+      if(best.score<MIN_SCORE) continue;
+      if(hits.size()<limit){
+        hits.push_back(best);
+        std::push_heap(hits.begin(), hits.end(), better);
+      }else if(better(best, hits.front())){
+        std::pop_heap(hits.begin(), hits.end(), better);
+        hits.back() = best;
+        std::push_heap(hits.begin(), hits.end(), better);
+      }
+    }
+  }
+
+  // Appends the distinct trigrams of the lowercased, padded text to grams
+  static void trigrams(std::string_view text, size_t limit, std::vector<uint32_t>& grams){
+    size_t n = std::min(text.size(), limit);
+    size_t first = grams.size();
+    uint32_t window = (static_cast<uint32_t>(PAD)<<8) | static_cast<uint32_t>(PAD);
+    for(size_t i=0; i<=n; i++){
+      unsigned char c = i<n ? std::tolower(static_cast<unsigned char>(text[i])) : PAD;
+      window = ((window<<8) | c) & 0xFFFFFF;
+      grams.push_back(window);
+    }
+    if(n==0) grams.resize(first);  // An empty field has no trigrams
+    std::sort(grams.begin()+first, grams.end());
+    grams.erase(std::unique(grams.begin()+first, grams.end()), grams.end());
+  }
+
+public:
+  size_t size() const{
+    return docs.size();
+  }
+
+  void clear(){
+    postings.clear();
+    docs.clear();
+    sizes.clear();
+  }
+
+  void reserve(size_t count){
+    docs.reserve(count);
+    sizes.reserve(count);
+  }
+
+  // Indexes a new entry at position size()
+  void add(std::string_view service, std::string_view username, std::string_view notes){
+    uint32_t pos = docs.size();
+    Doc doc;
+    FieldSizes size;
+    std::string_view fields[FIELDS] = {service, username, notes};
+    std::vector<uint32_t> grams;
+    for(int f=0; f<FIELDS; f++){
+      grams.clear();
+      trigrams(fields[f], MAX_FIELD, grams);
+      size.count[f] = grams.size();
+      for(uint32_t g : grams) doc.keys.push_back(g | static_cast<uint32_t>(f)<<24);
+    }
+    doc.slots.resize(doc.keys.size());
+    for(size_t i=0; i<doc.keys.size(); i++){
+      auto& list = postings[doc.keys[i]];
+      doc.slots[i] = list.size();
+      list.push_back(pos);
+    }
+    docs.push_back(std::move(doc));
+    sizes.push_back(size);
+  }
+
+  // Removes the entry at pos by moving the last entry into its slot, mirroring the storage's swap-pop
+  void remove(size_t pos){
+    Doc& doc = docs[pos];
+    for(size_t i=0; i<doc.keys.size(); i++){
+      auto list = postings.find(doc.keys[i]);
+      uint32_t slot = doc.slots[i];
+      uint32_t moved = list->second.back();
+      list->second[slot] = moved;
+      list->second.pop_back();
+      if(list->second.empty()){
+        postings.erase(list);
+      }else if(moved!=pos){
+        // The entry that took this slot records where it now sits in the list
+        Doc& other = docs[moved];
+        size_t k = std::lower_bound(other.keys.begin(), other.keys.end(), doc.keys[i])-other.keys.begin();
+        other.slots[k] = slot;
+      }
+    }
+    uint32_t last = docs.size()-1;
+    if(pos!=last){
+      Doc& tail = docs[last];
+      for(size_t i=0; i<tail.keys.size(); i++) postings[tail.keys[i]][tail.slots[i]] = pos;
+      docs[pos] = std::move(tail);
+      sizes[pos] = sizes[last];
+    }
+    docs.pop_back();
+    sizes.pop_back();
+  }
+
+  // Returns up to limit entries most similar to query, best first. Posting lists are scanned shortest first;
+  // once the candidates found so far fill the top limit with scores no unseen entry could reach through the
+  // remaining lists, those lists are not scanned and the candidates are finished by probing their own keys.
+  std::vector<Hit> search(std::string_view query, size_t limit) const{
+    std::vector<Hit> hits;
+    std::vector<uint32_t> grams;
+    trigrams(query, MAX_QUERY, grams);
+    if(grams.empty() || limit==0) return hits;
+    std::vector<Term> terms;
+    for(uint32_t g : grams){
+      for(int f=0; f<FIELDS; f++){
+        auto list = postings.find(g | static_cast<uint32_t>(f)<<24);
+        if(list!=postings.end()) terms.push_back({list->first, &list->second});
+      }
+    }
+    std::sort(terms.begin(), terms.end(), [](const Term& a, const Term& b){ return a.list->size()<b.list->size(); });
+    int unscanned[FIELDS] = {};
+    size_t unscannedPostings = 0;
+    for(const auto& t : terms){
+      unscanned[t.key>>24]++;
+      unscannedPostings += t.list->size();
+    }
+    double q = grams.size();
+    // Shared trigram counts per (entry, field) over the scanned lists, and the entries touched. The counts
+    // persist per thread and only touched entries are cleared afterwards, so a query doesn't zero them all.
+    static thread_local std::vector<uint8_t> shared;
+    if(shared.size()<docs.size()*FIELDS) shared.resize(docs.size()*FIELDS);
+    std::vector<uint32_t> touched;
+    size_t next = 0, probed = 0;
+    double threshold = 0;  // Lower bound on the limit-th best final score
+    for(; next<terms.size(); next++){
+      // Best score an entry not touched yet could still reach
+      double bound = 0;
+      for(int f=0; f<FIELDS; f++) bound = std::max(bound, WEIGHTS[f]*unscanned[f]/q);
+      // Stopping means probing every candidate's keys, which only pays while the candidates are few
+      // next to what is left to scan
+      if(touched.size()*PROBE_COST<=unscannedPostings){
+        if(bound<MIN_SCORE) break;
+        if(touched.size()>=limit && touched.size()!=probed){
+          score(touched, shared, terms, next, q, limit, hits);
+          if(hits.size()==limit) threshold = hits.front().score;
+          probed = touched.size();
+        }
+        if(bound<threshold) break;
+      }
+      const Term& term = terms[next];
+      int f = term.key>>24;
+      for(uint32_t pos : *term.list){
+        uint8_t* counts = &shared[static_cast<size_t>(pos)*FIELDS];
+        if(counts[0]==0 && counts[1]==0 && counts[2]==0) touched.push_back(pos);
+        counts[f]++;
+      }
+      unscanned[f]--;
+      unscannedPostings -= term.list->size();
+    }
+    score(touched, shared, terms, next, q, limit, hits);
+    for(uint32_t pos : touched) std::fill_n(&shared[static_cast<size_t>(pos)*FIELDS], FIELDS, 0);
+    std::sort_heap(hits.begin(), hits.end(), better);
+    return hits;
+  }
+};
+#endif
@@ -0,0 +1,217 @@
+// secure_memory.h
+#ifndef SECURE_MEMORY_H
+#define SECURE_MEMORY_H
+#include<string>
+#include<string_view>
+#include<vector>
+#include<mutex>
+#include<new>
+#include<utility>
+#include<cstddef>
+#include<cstdint>
+#include<sys/mman.h>
+#include<unistd.h>
+#include<openssl/crypto.h> // OPENSSL_cleanse, a zeroing the compiler can't elide
+
+// Memory for secrets: passwords, plaintexts and keys. Blocks come from mlock'd pages that are kept out of
+// swap and core dumps, and are zeroed with OPENSSL_cleanse when freed. Freed blocks go back to per-size free
+// lists, so the hot paths reuse buffers instead of allocating.
+class SecurePool{
+private:
+  static const size_t MIN_BLOCK = 32;            // Smallest size class
+  static const int CLASSES = 8;                  // Size classes 32 .. 4096 bytes
+  static const size_t SLAB_SIZE = 64*1024;       // Pages mapped at a time for the small size classes
+
+  struct FreeBlock{
+    FreeBlock* next;
+  };
+
+  std::mutex mutex;
+  FreeBlock* freeLists[CLASSES] = {};
+  size_t lockedBytes = 0;
+  size_t unlockedBytes = 0;                      // Mapped but not locked, e.g. over RLIMIT_MEMLOCK
+
+  static size_t pageSize(){
+    static const size_t size = ::sysconf(_SC_PAGESIZE);
+    return size;
+  }
+
+  static int sizeClass(size_t bytes){
+    int cls = 0;
+    for(size_t block=MIN_BLOCK; block<bytes; block<<=1) cls++;
+    return cls;
+  }
+
+  static size_t classSize(int cls){
+    return MIN_BLOCK<<cls;
+  }
+
+  static size_t roundToPages(size_t bytes){
+    return (bytes+pageSize()-1)/pageSize()*pageSize();
+  }
+
+  // Maps bytes of fresh pages and pins them; pages that can't be locked are still used, and counted
+  void* mapPages(size_t bytes){
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p==MAP_FAILED) throw std::bad_alloc();
+#ifdef MADV_DONTDUMP
+    ::madvise(p, bytes, MADV_DONTDUMP);
+#endif
+    if(::mlock(p, bytes)==0) lockedBytes += bytes;
+    else unlockedBytes += bytes;
+    return p;
+  }
+
+  void unmapPages(void* p, size_t bytes){
+    if(::munlock(p, bytes)==0) lockedBytes -= bytes;
+    else unlockedBytes -= bytes;
+    ::munmap(p, bytes);
+  }
+
+  SecurePool() = default;
+
+public:
+  SecurePool(const SecurePool&) = delete;
+  SecurePool& operator=(const SecurePool&) = delete;
+
+  // Never destroyed, so secrets in static objects can still be freed during exit
+  static SecurePool& instance(){
+    static SecurePool* pool = new SecurePool();
+    return *pool;
+  }
+
+  void* allocate(size_t bytes){
+    if(bytes>classSize(CLASSES-1)){
+      std::lock_guard<std::mutex> lock(mutex);
+      return mapPages(roundToPages(bytes));
+    }
+    int cls = sizeClass(bytes);
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!freeLists[cls]){
+      // Carve a new slab into blocks of this class
+      char* slab = static_cast<char*>(mapPages(SLAB_SIZE));
+      for(size_t offset=SLAB_SIZE; offset>0; offset-=classSize(cls)){
+        auto* block = reinterpret_cast<FreeBlock*>(slab+offset-classSize(cls));
+        block->next = freeLists[cls];
+        freeLists[cls] = block;
+      }
+    }
+    FreeBlock* block = freeLists[cls];
+    freeLists[cls] = block->next;
+    block->next = nullptr;
+    return block;
+  }
+
+  // Zeroes the block and returns it to its free list; large blocks are unmapped
+  void deallocate(void* p, size_t bytes){
+    if(!p) return;
+    if(bytes>classSize(CLASSES-1)){
+      OPENSSL_cleanse(p, bytes);
+      std::lock_guard<std::mutex> lock(mutex);
+      unmapPages(p, roundToPages(bytes));
+      return;
+    }
+    int cls = sizeClass(bytes);
+    OPENSSL_cleanse(p, classSize(cls));
+    std::lock_guard<std::mutex> lock(mutex);
+    auto* block = static_cast<FreeBlock*>(p);
+    block->next = freeLists[cls];
+    freeLists[cls] = block;
+  }
+
+  // Bytes mapped but not pinned in RAM, non-zero if mlock hit RLIMIT_MEMLOCK
+  size_t getUnlockedBytes(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return unlockedBytes;
+  }
+
+  size_t getLockedBytes(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return lockedBytes;
+  }
+};
+
+// Standard allocator over SecurePool
+template<typename T>
+struct SecureAllocator{
+  using value_type = T;
+
+  SecureAllocator() = default;
+  template<typename U>
+  SecureAllocator(const SecureAllocator<U>&){}
+
+  T* allocate(size_t n){
+    return static_cast<T*>(SecurePool::instance().allocate(n*sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n){
+    SecurePool::instance().deallocate(p, n*sizeof(T));
+  }
+
+  template<typename U>
+  bool operator==(const SecureAllocator<U>&) const{
+    return true;
+  }
+
+  template<typename U>
+  bool operator!=(const SecureAllocator<U>&) const{
+    return false;
+  }
+};
+
+// Key material and other secret bytes
+using SecureBytes = std::vector<unsigned char, SecureAllocator<unsigned char>>;
+
+// String for passwords. Heap buffers come from SecurePool; the destructor also zeroes the inline
+// short-string buffer, which lives inside the object itself.
+class SecureString : public std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>{
+private:
+  using Base = std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
+
+public:
+  using Base::Base;
+  SecureString() = default;
+  SecureString(const SecureString&) = default;
+  SecureString(SecureString&&) = default;
+  SecureString(const Base& other) : Base(other){}
+  explicit SecureString(const std::string& text) : Base(text.data(), text.size()){}
+  explicit SecureString(std::string_view text) : Base(text.data(), text.size()){}
+
+  // Assignments zero the old contents first, since an inline buffer isn't freed through the allocator
+  SecureString& operator=(const SecureString& other){
+    if(this!=&other){
+      wipe();
+      Base::assign(other);
+    }
+    return *this;
+  }
+
+  SecureString& operator=(SecureString&& other){
+    if(this!=&other){
+      wipe();
+      Base::operator=(std::move(other));
+    }
+    return *this;
+  }
+
+  SecureString& operator=(std::string_view text){
+    wipe();
+    Base::assign(text.data(), text.size());
+    return *this;
+  }
+
+  SecureString& operator=(const char* text){
+    return *this = std::string_view(text);
+  }
+
+  ~SecureString(){
+    OPENSSL_cleanse(Base::data(), Base::capacity());
+  }
+
+  // Zeroes the contents and empties the string, keeping its buffer for reuse
+  void wipe(){
+    OPENSSL_cleanse(Base::data(), Base::capacity());
+    Base::clear();
+  }
+};
+#endif
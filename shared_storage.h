@@ -0,0 +1,179 @@
+// shared_storage.h
+#ifndef SHARED_STORAGE_H
+#define SHARED_STORAGE_H
+#include<string>
+#include<string_view>
+#include<vector>
+#include<memory>
+#include<mutex>
+#include<shared_mutex>
+#include<atomic>
+#include<chrono>
+#include "password_storage.h"
+#include "secure_memory.h"
+
+// A vault shared by many threads of this process and by other processes. Reads run concurrently under a
+// shared lock, each thread decrypting with its own cipher contexts; writes are serialized, within the
+// process by a mutex and across processes by the vault's file lock, and always apply to the newest state
+// on disk. A write encrypts and fsyncs its journal record before taking the exclusive lock, which it holds
+// only to apply the record in memory, so readers never wait on disk I/O and never see an unwritten change.
+// Changes other processes make are picked up by comparing the files' stamps (inode, size, mtime) at most
+// every REFRESH_INTERVAL on reads and always before a write.
+class SharedStorage{
+public:
+  static constexpr std::chrono::milliseconds REFRESH_INTERVAL{50};
+
+private:
+  std::string filename;
+  SecureString masterPassword;
+  std::unique_ptr<PasswordStorage> store;
+  std::shared_mutex mutex;           // Guards store: shared for reads, exclusive to swap it or apply a change
+  std::mutex writer;                 // One thread writes or reloads at a time
+  std::atomic<int64_t> nextCheck{0}; // Steady-clock time in ns of the next stamp check on the read path
+
+  static int64_t now(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  static PasswordStorage::CryptoWorker& worker(){
+    static thread_local PasswordStorage::CryptoWorker crypto;
+    return crypto;
+  }
+
+  // If the files changed, loads them into a fresh storage off to the side and swaps it in, so readers only
+  // wait for the swap. The caller holds writer and the file lock.
+  void reload(){
+    if(!store->changedOnDisk()) return;
+    auto fresh = std::make_unique<PasswordStorage>(filename, masterPassword);
+    fresh->load();
+    fresh->takeOver(*store);
+    fresh->unlock();
+    fresh->materialize();  // Applying writes needs the entries in memory; copy them out now, not under the lock
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    store = std::move(fresh);
+  }
+
+  // reload() under a shared file lock, which keeps writers in other processes from appending mid-read
+  void reloadShared(){
+    store->lockFile(false);
+    try{
+      reload();
+    }catch(...){
+      store->unlockFile();
+      throw;
+    }
+    store->unlockFile();
+  }
+
+  // Reloads on the read path if the check is due and no writer is busy; a busy writer reloads anyway
+  void refreshIfDue(){
+    int64_t t = now();
+    int64_t due = nextCheck.load(std::memory_order_relaxed);
+    if(t<due || !nextCheck.compare_exchange_strong(due, t+std::chrono::nanoseconds(REFRESH_INTERVAL).count())) return;
+    std::unique_lock<std::mutex> busy(writer, std::try_to_lock);
+    if(!busy.owns_lock()) return;
+    reloadShared();
+  }
+
+  // One read-modify-write against the vault on disk: stage(store, records) builds the change's journal
+  // records from the newest state without modifying it, they are appended to the journal, and only then
+  // applied under the exclusive lock. Only the writer thread touches the store outside the shared lock,
+  // and the parts it changes there (journal bookkeeping, a compaction snapshot) aren't read by readers.
+  template<typename Fn>
+  bool write(Fn stage){
+    std::lock_guard<std::mutex> busy(writer);
+    store->lockFile(true);
+    try{
+      reload();
+      std::vector<std::string> records;
+      bool changed = stage(*store, records);
+      if(changed){
+        bool appended = store->appendStaged(records);
+        {
+          std::unique_lock<std::shared_mutex> lock(mutex);
+          store->applyStaged(records, appended);
+        }
+        store->commit();  // Writes a snapshot when one is due or the records couldn't be appended
+      }
+      store->unlockFile();
+      return changed;
+    }catch(...){
+      store->unlockFile();
+      throw;
+    }
+  }
+
+public:
+  // Loads and unlocks the vault; throws on a wrong master password
+  SharedStorage(const std::string& file, std::string_view master)
+    : filename(file), masterPassword(master), store(std::make_unique<PasswordStorage>(file, master)){
+    store->lockFile(false);
+    try{
+      store->load();
+    }catch(...){
+      store->unlockFile();
+      throw;
+    }
+    store->unlockFile();
+    store->unlock();
+    store->materialize();
+    nextCheck = now()+std::chrono::nanoseconds(REFRESH_INTERVAL).count();
+  }
+
+  SecureString getPassword(const std::string& service, const std::string& username=""){
+    refreshIfDue();
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return store->getPassword(worker(), service, username);
+  }
+
+  std::vector<PasswordEntry> findEntries(const std::string& service, const std::string& username=""){
+    refreshIfDue();
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return store->findEntries(service, username);
+  }
+
+  std::vector<PasswordStorage::SearchResult> search(std::string_view query, size_t limit=10){
+    refreshIfDue();
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return store->findSimilar(query, limit);
+  }
+
+  int getEntryCount(){
+    refreshIfDue();
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return store->getEntryCount();
+  }
+
+  // Writes are committed before they return
+  void addEntry(const std::string& service, const std::string& username, std::string_view password, const std::string& notes=""){
+    write([&](const PasswordStorage& s, std::vector<std::string>& records){
+      records.push_back(s.stageAdd(worker(), service, username, password, notes));
+      return true;
+    });
+  }
+
+  bool updateEntry(const std::string& service, const std::string& username, std::string_view password){
+    return write([&](const PasswordStorage& s, std::vector<std::string>& records){
+      std::string record;
+      if(!s.stageUpdate(worker(), service, username, password, record)) return false;
+      records.push_back(std::move(record));
+      return true;
+    });
+  }
+
+  bool deleteEntry(const std::string& service, const std::string& username=""){
+    return write([&](const PasswordStorage& s, std::vector<std::string>& records){
+      std::string record;
+      if(!s.stageDelete(service, username, record)) return false;
+      records.push_back(std::move(record));
+      return true;
+    });
+  }
+
+  // Picks up other processes' changes now rather than at the next due check
+  void refresh(){
+    std::lock_guard<std::mutex> busy(writer);
+    reloadShared();
+  }
+};
+#endif
@@ -0,0 +1,440 @@
+// strength_estimator.h
+#ifndef STRENGTH_ESTIMATOR_H
+#define STRENGTH_ESTIMATOR_H
+#include<string>
+#include<string_view>
+#include<vector>
+#include<algorithm>
+#include<cmath>
+#include<cstdint>
+#include<cstring>
+
+// zxcvbn-style password strength estimation. A password is split into the cheapest sequence of patterns an
+// attacker would try: common passwords and words (with capitals and l33t substitutions), keyboard walks,
+// alphabetic or numeric sequences, repeats and dates. Characters no pattern covers are brute-forced over the
+// character classes present. The result is the estimated guess count in bits.
+//
+// The dictionary is a flat array trie (nodes and edges indexed by position, no pointers) built once from the
+// ranked word list below, so it could equally be written to a file and mapped. Estimation allocates nothing;
+// passwords longer than MAX_ANALYZED characters are brute-forced past that point.
+class StrengthEstimator{
+public:
+  static constexpr size_t MAX_ANALYZED = 128;
+  static constexpr double STRONG_BITS = 80.0;  // Entropy scored as 100
+
+  enum Pattern{
+    BRUTEFORCE = 0,
+    DICTIONARY,
+    KEYBOARD_WALK,
+    SEQUENCE,
+    REPEAT,
+    DATE
+  };
+
+  struct Estimate{
+    double bits = 0;                // log2 of the estimated number of guesses
+    int score = 0;                  // 0-100, STRONG_BITS and above score 100
+    Pattern weakest = BRUTEFORCE;   // Pattern covering the most characters, BRUTEFORCE if none
+  };
+
+  static const char* patternName(Pattern pattern){
+    switch(pattern){
+      case DICTIONARY: return "dictionary";
+      case KEYBOARD_WALK: return "keyboard-walk";
+      case SEQUENCE: return "sequence";
+      case REPEAT: return "repeat";
+      case DATE: return "date";
+      default: return "bruteforce";
+    }
+  }
+
+private:
+  // Common passwords and words, most common first; the position is the guess rank
+  static constexpr const char* WORDS[] = {
+    "123456", "password", "123456789", "12345678", "12345", "qwerty", "1234567", "111111", "1234567890", "123123",
+    "abc123", "1234", "password1", "iloveyou", "1q2w3e4r", "000000", "qwerty123", "zaq12wsx", "dragon", "sunshine",
+    "princess", "letmein", "654321", "monkey", "27653", "1qaz2wsx", "123321", "qwertyuiop", "superman", "asdfghjkl",
+    "trustno1", "football", "baseball", "welcome", "admin", "master", "hello", "freedom", "whatever", "qazwsx",
+    "shadow", "michael", "jennifer", "ashley", "hunter", "soccer", "charlie", "jordan", "harley", "ranger",
+    "buster", "thomas", "tigger", "robert", "batman", "killer", "pepper", "hockey", "daniel", "starwars",
+    "andrew", "access", "love", "secret", "summer", "flower", "cheese", "computer", "internet", "orange",
+    "maggie", "ginger", "joshua", "mustang", "matthew", "liverpool", "chelsea", "arsenal", "yankees", "cowboys",
+    "eagles", "lakers", "corvette", "mercedes", "ferrari", "porsche", "nicole", "jessica", "amanda", "michelle",
+    "sophie", "hannah", "samantha", "anthony", "william", "taylor", "austin", "bailey", "banana", "apple",
+    "chocolate", "cookie", "butterfly", "purple", "silver", "golden", "diamond", "angel", "lovely", "babygirl",
+    "blink182", "pokemon", "naruto", "minecraft", "google", "facebook", "linkedin", "samsung", "iphone", "windows",
+    "ubuntu", "linux", "oracle", "changeme", "default", "guest", "root", "test", "test123", "login",
+    "passw0rd", "abcdef", "abcd1234", "asdf", "zxcvbnm", "q1w2e3r4", "1q2w3e", "aaaaaa", "112233", "121212",
+    "696969", "987654321", "159753", "147258369", "666666", "888888", "7777777", "101010", "qwe123", "1qazxsw2",
+    "qwerty1", "password123", "admin123", "root123", "welcome1", "letmein1", "monkey1", "dragon1", "iloveyou1", "princess1",
+    "secret1", "hello123", "master1", "summer1", "football1", "baseball1", "superman1", "batman1", "shadow1", "sunshine1",
+    "charlie1", "jordan23", "michael1", "jennifer1", "hunter2", "soccer1", "love123", "abc1234", "pass", "pass123",
+    "qwer1234", "asdf1234", "zxcv1234", "123qwe", "123abc", "a123456", "qwertyu", "asdfgh", "zxcvbn", "qazwsxedc",
+    "money", "family", "friend", "friends", "happy", "music", "ninja", "tiger", "lion", "phoenix",
+    "matrix", "world", "peace", "heaven", "jesus", "christ", "god", "blessed", "faith", "hope",
+    "spring", "winter", "autumn", "fall", "january", "february", "march", "april", "may", "june",
+    "july", "august", "september", "october", "november", "december", "monday", "tuesday", "wednesday", "thursday",
+    "friday", "saturday", "sunday", "morning", "night", "midnight", "weekend", "holiday", "birthday", "christmas",
+    "house", "home", "garden", "forest", "river", "ocean", "mountain", "island", "beach", "sunset",
+    "star", "moon", "planet", "galaxy", "rocket", "space", "thunder", "storm", "lightning", "rainbow",
+    "fire", "water", "earth", "wind", "ice", "snow", "rain", "cloud", "sky", "sun",
+    "dog", "cat", "puppy", "kitty", "horse", "bear", "wolf", "fox", "eagle", "falcon",
+    "shark", "dolphin", "monkey123", "panda", "rabbit", "bunny", "turtle", "snake", "spider", "dragonfly",
+    "red", "blue", "green", "yellow", "black", "white", "pink", "brown", "gray", "violet",
+    "king", "queen", "prince", "knight", "warrior", "soldier", "hero", "legend", "wizard", "magic",
+    "captain", "doctor", "angel1", "devil", "demon", "ghost", "zombie", "vampire", "monster", "alien",
+    "coffee", "pizza", "burger", "sugar", "honey", "candy", "cherry", "lemon", "peach", "mango",
+    "car", "truck", "bike", "boat", "plane", "train", "jeep", "honda", "toyota", "ford",
+    "bmw", "audi", "nissan", "chevy", "dodge", "harley1", "yamaha", "ducati", "volvo", "tesla",
+    "james", "john", "david", "richard", "joseph", "charles", "christopher", "mark", "paul", "steven",
+    "kevin", "brian", "george", "edward", "ronald", "timothy", "jason", "jeffrey", "ryan", "jacob",
+    "gary", "nicholas", "eric", "jonathan", "stephen", "larry", "justin", "scott", "brandon", "benjamin",
+    "mary", "patricia", "linda", "barbara", "elizabeth", "susan", "sarah", "karen", "nancy", "lisa",
+    "betty", "margaret", "sandra", "emily", "donna", "carol", "melissa", "deborah", "stephanie", "rebecca",
+    "laura", "sharon", "cynthia", "kathleen", "amy", "shirley", "angela", "helen", "anna", "brenda",
+    "alex", "max", "sam", "ben", "jack", "oliver", "harry", "charlotte", "emma", "olivia",
+    "sophia", "isabella", "mia", "lucas", "ethan", "noah", "liam", "mason", "logan", "aiden",
+    "player", "gamer", "games", "hacker", "coder", "admin1", "administrator", "user", "username", "system",
+    "server", "network", "database", "backup", "office", "company", "business", "work", "school", "college",
+    "student", "teacher", "london", "paris", "berlin", "tokyo", "newyork", "boston", "chicago", "dallas",
+    "texas", "california", "florida", "america", "canada", "england", "france", "germany", "italy", "spain",
+    "mexico", "brazil", "india", "china", "japan", "russia", "australia", "ireland", "scotland", "london1",
+    "cowboy", "rangers", "steelers", "packers", "redsox", "giants", "patriots", "broncos", "dolphins", "raiders",
+    "barcelona", "madrid", "juventus", "milan", "united", "city", "real", "bayern", "celtic", "rangers1",
+    "guitar", "piano", "drums", "rock", "metal", "punk", "jazz", "blues", "disco", "dance",
+    "slipknot", "metallica", "nirvana", "beatles", "eminem", "tupac", "rihanna", "beyonce", "madonna", "elvis",
+    "mickey", "minnie", "donald", "goofy", "snoopy", "garfield", "scooby", "simpsons", "homer", "bart",
+    "spiderman", "ironman", "hulk", "thor", "wolverine", "superman123", "batman123", "joker", "gandalf", "frodo",
+    "hogwarts", "potter", "voldemort", "yoda", "vader", "skywalker", "jedi", "sith", "trek", "enterprise",
+    "sweet", "sexy", "cute", "pretty", "beautiful", "handsome", "baby", "babe", "honey1", "darling",
+    "forever", "always", "together", "lover", "kiss", "hugs", "heart", "sweetheart", "soulmate", "romance",
+    "fuck", "fuckyou", "shit", "bitch", "asshole", "dick", "pussy", "cock", "whore", "bastard",
+    "qwerty12", "1qaz", "2wsx", "3edc", "zaq1", "xsw2", "1234qwer", "qweasd", "qweasdzxc", "asdzxc",
+  };
+
+  // Flat trie: node i has edges [firstEdge, firstEdge+edgeCount) sorted by label; rank 0 means no word ends here
+  struct Node{
+    uint32_t firstEdge = 0;
+    uint32_t edgeCount = 0;
+    uint32_t rank = 0;
+  };
+
+  struct Edge{
+    unsigned char label;
+    uint32_t child;
+  };
+
+  std::vector<Node> nodes;
+  std::vector<Edge> edges;
+  uint32_t rootChild[256];  // Children of the root, indexed directly since every lookup starts there
+
+  // Keyboard coordinates in quarter-key units: x = 4*column + row stagger, or row -1 for keys not on the layout
+  struct Key{
+    int8_t row = -1;
+    int16_t x = 0;
+    bool shifted = false;
+  };
+  Key keys[256];
+
+  // Builds the trie level by level from the ranked word list
+  StrengthEstimator(){
+    std::vector<std::pair<std::string, uint32_t>> words;
+    uint32_t rank = 1;
+    for(const char* word : WORDS) words.emplace_back(word, rank++);
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end(), [](const auto& a, const auto& b){ return a.first==b.first; }), words.end());
+    // Each pending range of words shares a prefix of length depth and maps to one node
+    struct Range{
+      size_t begin, end, depth;
+      uint32_t node;
+    };
+    nodes.emplace_back();
+    std::vector<Range> level = {{0, words.size(), 0, 0}}, next;
+    while(!level.empty()){
+      next.clear();
+      for(const Range& r : level){
+        size_t i = r.begin;
+        if(i<r.end && words[i].first.size()==r.depth){
+          nodes[r.node].rank = words[i].second;
+          i++;
+        }
+        nodes[r.node].firstEdge = edges.size();
+        while(i<r.end){
+          unsigned char label = words[i].first[r.depth];
+          size_t j = i;
+          while(j<r.end && static_cast<unsigned char>(words[j].first[r.depth])==label) j++;
+          uint32_t child = nodes.size();
+          nodes.emplace_back();
+          edges.push_back({label, child});
+          nodes[r.node].edgeCount++;
+          next.push_back({i, j, r.depth+1, child});
+          i = j;
+        }
+      }
+      level.swap(next);
+    }
+    std::fill(rootChild, rootChild+256, 0);
+    for(uint32_t e=0; e<nodes[0].edgeCount; e++) rootChild[edges[e].label] = edges[e].child;
+    buildKeyboard();
+  }
+
+  void buildKeyboard(){
+    static const char* const rows[] = {"`1234567890-=", "qwertyuiop[]\\", "asdfghjkl;'", "zxcvbnm,./"};
+    static const char* const shiftedRows[] = {"~!@#$%^&*()_+", "QWERTYUIOP{}|", "ASDFGHJKL:\"", "ZXCVBNM<>?"};
+    static const int stagger[] = {0, 6, 7, 9};
+    for(int r=0; r<4; r++){
+      for(int c=0; rows[r][c]; c++){
+        keys[static_cast<unsigned char>(rows[r][c])] = {static_cast<int8_t>(r), static_cast<int16_t>(4*c+stagger[r]), false};
+        keys[static_cast<unsigned char>(shiftedRows[r][c])] = {static_cast<int8_t>(r), static_cast<int16_t>(4*c+stagger[r]), true};
+      }
+    }
+  }
+
+  uint32_t child(uint32_t node, unsigned char label) const{
+    if(node==0) return rootChild[label];
+    const Edge* first = edges.data()+nodes[node].firstEdge;
+    for(uint32_t e=0; e<nodes[node].edgeCount; e++){
+      if(first[e].label==label) return first[e].child;
+    }
+    return 0;
+  }
+
+  bool adjacent(unsigned char a, unsigned char b) const{
+    const Key& ka = keys[a];
+    const Key& kb = keys[b];
+    if(ka.row<0 || kb.row<0) return false;
+    int dr = std::abs(ka.row-kb.row), dx = std::abs(ka.x-kb.x);
+    if(dr==0) return dx==4;
+    return dr==1 && dx<=4;
+  }
+
+  static unsigned char lower(unsigned char c){
+    return c>='A' && c<='Z' ? c+32 : c;
+  }
+
+  // Letter a l33t substitution stands for, or 0
+  static unsigned char unleet(unsigned char c){
+    switch(c){
+      case '4': case '@': return 'a';
+      case '3': return 'e';
+      case '1': case '!': return 'i';
+      case '0': return 'o';
+      case '5': case '$': return 's';
+      case '7': case '+': return 't';
+      default: return 0;
+    }
+  }
+
+  static int charClass(unsigned char c){
+    if(c>='a' && c<='z') return 0;
+    if(c>='A' && c<='Z') return 1;
+    if(c>='0' && c<='9') return 2;
+    if(c>=0x20 && c<0x7F) return 3;
+    return 4;
+  }
+
+  static double log2Binomial(int n, int k){
+    return (std::lgamma(n+1.0)-std::lgamma(k+1.0)-std::lgamma(n-k+1.0))/std::log(2.0);
+  }
+
+  // Extra bits for capitalization of a dictionary match: none for lowercase, one for a leading, trailing or
+  // all-caps word, otherwise the number of ways to place that many capitals
+  static double uppercaseBits(std::string_view word){
+    int upper = 0, letters = 0;
+    for(unsigned char c : word){
+      if(c>='A' && c<='Z') upper++;
+      if(charClass(c)<=1) letters++;
+    }
+    if(upper==0) return 0;
+    unsigned char first = word.front(), last = word.back();
+    if(upper==letters || (upper==1 && ((first>='A' && first<='Z') || (last>='A' && last<='Z')))) return 1;
+    double sum = 0;
+    for(int i=1; i<=std::min(upper, letters-upper); i++) sum += std::exp2(log2Binomial(letters, i));
+    return std::log2(std::max(sum, 2.0));
+  }
+
+  static double log2Of(double guesses){
+    return std::log2(std::max(guesses, 1.0));
+  }
+
+  static bool isDigit(unsigned char c){
+    return c>='0' && c<='9';
+  }
+
+  static int number(const char* p, int digits){
+    int n = 0;
+    for(int i=0; i<digits; i++) n = n*10 + (p[i]-'0');
+    return n;
+  }
+
+  static bool validDayMonth(int a, int b){
+    return (a>=1 && a<=31 && b>=1 && b<=12) || (a>=1 && a<=12 && b>=1 && b<=31);
+  }
+
+  // Bits of a date occupying all of p[0, len), or a negative value if it isn't one. Recognizes years,
+  // ddmm/mmdd, ddmmyy, ddmmyyyy and yyyymmdd (either day-month order), with or without -, / or . separators.
+  static double dateBits(const char* p, size_t len){
+    char digits[8];
+    size_t n = 0, separators = 0;
+    char separator = 0;
+    for(size_t i=0; i<len; i++){
+      if(isDigit(p[i])){
+        if(n==8) return -1;
+        digits[n++] = p[i];
+      }else if(p[i]=='-' || p[i]=='/' || p[i]=='.'){
+        if(i==0 || i==len-1 || !isDigit(p[i-1]) || (separator && p[i]!=separator)) return -1;
+        separator = p[i];
+        separators++;
+      }else{
+        return -1;
+      }
+    }
+    double extra = separators ? 2 : 0;  // Choice of separator
+    if(separators==1 || separators>2) return -1;
+    if(n==4 && separators==0){
+      int year = number(digits, 4);
+      if(year>=1900 && year<=2039) return log2Of(140);
+      if(validDayMonth(number(digits, 2), number(digits+2, 2))) return log2Of(366);
+      return -1;
+    }
+    if(n==6 && validDayMonth(number(digits, 2), number(digits+2, 2))) return log2Of(366.0*100)+extra;
+    if(n==6 && validDayMonth(number(digits+2, 2), number(digits+4, 2))) return log2Of(366.0*100)+extra;
+    if(n==8){
+      int yearLast = number(digits+4, 4), yearFirst = number(digits, 4);
+      if(yearLast>=1900 && yearLast<=2039 && validDayMonth(number(digits, 2), number(digits+2, 2))) return log2Of(366.0*140)+extra;
+      if(yearFirst>=1900 && yearFirst<=2039 && validDayMonth(number(digits+4, 2), number(digits+6, 2))) return log2Of(366.0*140)+extra;
+    }
+    return -1;
+  }
+
+public:
+  StrengthEstimator(const StrengthEstimator&) = delete;
+  StrengthEstimator& operator=(const StrengthEstimator&) = delete;
+
+  // Shared estimator; const and safe to use from several threads
+  static const StrengthEstimator& instance(){
+    static const StrengthEstimator estimator;
+    return estimator;
+  }
+
+  size_t dictionarySize() const{
+    return sizeof(WORDS)/sizeof(WORDS[0]);
+  }
+
+  // Estimates the guesses needed for password by finding the cheapest way to cover it with patterns
+  Estimate estimate(std::string_view password) const{
+    size_t n = std::min(password.size(), MAX_ANALYZED);
+    const char* s = password.data();
+    // Brute-force cardinality from the character classes present anywhere in the password
+    static const int classSizes[] = {26, 26, 10, 33, 100};
+    bool present[5] = {};
+    for(unsigned char c : password) present[charClass(c)] = true;
+    int cardinality = 0;
+    for(int i=0; i<5; i++) if(present[i]) cardinality += classSizes[i];
+    double charBits = std::log2(std::max(cardinality, 10));
+
+    double best[MAX_ANALYZED+1];
+    int8_t pattern[MAX_ANALYZED+1];
+    uint8_t from[MAX_ANALYZED+1];
+    best[0] = 0;
+    for(size_t i=1; i<=n; i++) best[i] = 1e300;
+    // Relaxes the cover ending at end with a match starting at start; each pattern costs one extra bit
+    auto relax = [&](size_t start, size_t end, double bits, Pattern p){
+      double total = best[start] + bits + 1;
+      if(total<best[end]){
+        best[end] = total;
+        pattern[end] = p;
+        from[end] = start;
+      }
+    };
+    for(size_t i=0; i<n; i++){
+      // best[i] is final here: every match ending at i starts before it
+      if(best[i]+charBits<best[i+1]){
+        best[i+1] = best[i]+charBits;
+        pattern[i+1] = BRUTEFORCE;
+        from[i+1] = i;
+      }
+      // Dictionary words, as typed and with l33t substitutions undone
+      for(int leet=0; leet<2; leet++){
+        uint32_t node = 0;
+        int substitutions = 0;
+        for(size_t j=i; j<n; j++){
+          unsigned char c = lower(s[j]);
+          if(leet){
+            unsigned char letter = unleet(c);
+            if(letter){
+              c = letter;
+              substitutions++;
+            }
+          }
+          node = child(node, c);
+          if(!node) break;
+          if(nodes[node].rank && j+1-i>=3 && (!leet || substitutions>0)){
+            double bits = log2Of(nodes[node].rank) + uppercaseBits(std::string_view(s+i, j+1-i)) + substitutions;
+            relax(i, j+1, bits, DICTIONARY);
+          }
+        }
+      }
+      // Keyboard walks: runs of adjacent keys; each change of direction multiplies the choices
+      {
+        int turns = 0, shifted = keys[static_cast<unsigned char>(s[i])].shifted;
+        int lastDr = 99, lastDx = 99;
+        for(size_t j=i+1; j<n && adjacent(s[j-1], s[j]); j++){
+          const Key& a = keys[static_cast<unsigned char>(s[j-1])];
+          const Key& b = keys[static_cast<unsigned char>(s[j])];
+          int dr = b.row-a.row, dx = b.x>a.x ? 1 : (b.x<a.x ? -1 : 0);
+          if(dr!=lastDr || dx!=lastDx) turns++;
+          lastDr = dr;
+          lastDx = dx;
+          shifted += b.shifted;
+          size_t len = j+1-i;
+          if(len>=3){
+            int unshifted = static_cast<int>(len)-shifted;
+            double shiftBits = shifted==0 ? 0 : (unshifted==0 ? 1 : log2Binomial(len, std::min(shifted, unshifted))+1);
+            relax(i, j+1, std::log2(47.0) + std::log2(static_cast<double>(len)) + 2.0*turns + shiftBits, KEYBOARD_WALK);
+          }
+        }
+      }
+      // Sequences: constant step of +1 or -1 within letters or digits
+      if(i+1<n){
+        int step = static_cast<unsigned char>(s[i+1]) - static_cast<unsigned char>(s[i]);
+        int cls = charClass(s[i]);
+        if((step==1 || step==-1) && cls<=2){
+          for(size_t j=i+1; j<n && charClass(s[j])==cls && static_cast<unsigned char>(s[j])-static_cast<unsigned char>(s[j-1])==step; j++){
+            size_t len = j+1-i;
+            if(len<3) continue;
+            unsigned char first = lower(s[i]);
+            double startBits = (first=='a' || first=='z' || first=='0' || first=='1' || first=='9') ? 2 : std::log2(cls==2 ? 10.0 : 26.0);
+            relax(i, j+1, startBits + std::log2(static_cast<double>(len)) + (step<0 ? 1 : 0), SEQUENCE);
+          }
+        }
+      }
+      // Repeats of a block of 1 to 4 characters, at least three characters long in total
+      for(size_t period=1; period<=4 && i+2*period<=n; period++){
+        size_t j = i+period;
+        while(j<n && s[j]==s[j-period]) j++;
+        for(size_t end=i+std::max<size_t>(2*period, 3); end<=j; end++){
+          double blockBits = period==1 ? std::log2(static_cast<double>(classSizes[charClass(s[i])])) : period*charBits;
+          relax(i, end, blockBits + std::log2(static_cast<double>(end-i)/period), REPEAT);
+        }
+      }
+      // Dates, 4 to 10 characters
+      for(size_t len=4; len<=10 && i+len<=n; len++){
+        double bits = dateBits(s+i, len);
+        if(bits>=0) relax(i, i+len, bits, DATE);
+      }
+    }
+    Estimate result;
+    result.bits = best[n] + charBits*(password.size()-n);
+    result.score = static_cast<int>(std::min(100.0, std::round(result.bits*100/STRONG_BITS)));
+    size_t longest = 0;
+    for(size_t end=n; end>0; end=from[end]){
+      if(pattern[end]!=BRUTEFORCE && end-from[end]>longest){
+        longest = end-from[end];
+        result.weakest = static_cast<Pattern>(pattern[end]);
+      }
+    }
+    return result;
+  }
+};
+#endif
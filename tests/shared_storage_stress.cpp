@@ -0,0 +1,138 @@
+// shared_storage_stress.cpp
+// Hammers one scratch vault from several processes of several threads through SharedStorage, then checks
+// from a fresh load that every entry written is there and decrypts. Run by ctest; optional arguments are
+// PROCESSES THREADS OPS (operations per thread). The vault lives in a mkdtemp directory removed afterwards.
+#include<cstdio>
+#include<cstdlib>
+#include<cerrno>
+#include<string>
+#include<string_view>
+#include<vector>
+#include<thread>
+#include<random>
+#include<chrono>
+#include<stdexcept>
+#include<unistd.h>
+#include<sys/wait.h>
+#include "shared_storage.h"
+
+namespace{
+  const char* const MASTER = "stress-master-password";
+  const size_t WRITE_EVERY = 8;  // One operation in this many adds an entry
+  const size_t UPDATE_EVERY = 16;  // And one in this many re-encrypts one
+
+  // One worker thread: adds entries named prefix+N, updates them, looks them up, searches for any process's
+  // entries and counts. Every password is "secret:" + its service, so any reader can check any entry it
+  // finds. Returns the number of wrong or missing results.
+  size_t stressThread(SharedStorage& shared, const std::string& prefix, size_t ops){
+    std::mt19937 rng(std::random_device{}());
+    std::vector<std::string> written;
+    size_t failures = 0;
+    auto check = [&](const std::string& service, const std::string& username){
+      try{
+        if(std::string_view(shared.getPassword(service, username))!="secret:"+service) failures++;
+      }catch(const std::exception&){
+        failures++;
+      }
+    };
+    for(size_t i=0; i<ops; i++){
+      if(i%WRITE_EVERY==0){
+        std::string service = prefix+std::to_string(written.size());
+        shared.addEntry(service, "stress", "secret:"+service);
+        written.push_back(service);
+      }else if(i%UPDATE_EVERY==WRITE_EVERY/2){
+        const std::string& service = written[rng()%written.size()];
+        if(!shared.updateEntry(service, "stress", "secret:"+service)) failures++;
+      }else if(i%3==0){
+        check(written[rng()%written.size()], "stress");
+      }else if(i%3==1){
+        auto hits = shared.search("stress-", 5);
+        if(hits.empty()) failures++;
+        for(const auto& hit : hits) check(hit.entry.service, hit.entry.username);
+      }else if(shared.getEntryCount()<static_cast<int>(written.size())){
+        failures++;
+      }
+    }
+    return failures;
+  }
+
+  // Runs in a forked child; returns its exit code
+  int stressProcess(const std::string& vault, int process, size_t threads, size_t ops){
+    try{
+      SharedStorage shared(vault, MASTER);
+      std::vector<size_t> failures(threads);
+      std::vector<std::thread> pool;
+      for(size_t t=0; t<threads; t++){
+        std::string prefix = "stress-"+std::to_string(process)+"-"+std::to_string(t)+"-";
+        pool.emplace_back([&, prefix, t](){
+          try{
+            failures[t] = stressThread(shared, prefix, ops);
+          }catch(const std::exception& e){
+            std::fprintf(stderr, "process %d thread %zu: %s\n", process, t, e.what());
+            failures[t] = 1;
+          }
+        });
+      }
+      for(auto& thread : pool) thread.join();
+      for(size_t f : failures){
+        if(f) return 1;
+      }
+      return 0;
+    }catch(const std::exception& e){
+      std::fprintf(stderr, "process %d: %s\n", process, e.what());
+      return 1;
+    }
+  }
+}
+
+int main(int argc, char** argv){
+  int processes = argc>1 ? std::atoi(argv[1]) : 4;
+  size_t threads = argc>2 ? std::atoi(argv[2]) : 4;
+  size_t ops = argc>3 ? std::atoi(argv[3]) : 200;
+  if(processes<1 || threads<1 || ops<1){
+    std::fprintf(stderr, "usage: %s [PROCESSES THREADS OPS]\n", argv[0]);
+    return 2;
+  }
+  char pattern[] = "/tmp/passanomix-stress-XXXXXX";
+  if(!::mkdtemp(pattern)){
+    std::perror("mkdtemp");
+    return 1;
+  }
+  std::string dir = pattern;
+  std::string vault = dir+"/vault.json";
+  auto start = std::chrono::steady_clock::now();
+  std::vector<pid_t> children;
+  for(int p=0; p<processes; p++){
+    pid_t pid = ::fork();
+    if(pid<0){
+      std::perror("fork");
+      break;
+    }
+    if(pid==0) ::_exit(stressProcess(vault, p, threads, ops));
+    children.push_back(pid);
+  }
+  int failedProcesses = processes-static_cast<int>(children.size());
+  for(pid_t pid : children){
+    int status = 0;
+    while(::waitpid(pid, &status, 0)<0 && errno==EINTR){}
+    if(!WIFEXITED(status) || WEXITSTATUS(status)!=0) failedProcesses++;
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+  size_t expected = processes*threads*((ops+WRITE_EVERY-1)/WRITE_EVERY), verified = 0;
+  try{
+    PasswordStorage check(vault, MASTER);
+    check.load();
+    check.unlock();
+    for(const auto& e : check.findByPrefix("stress-")){
+      if(e.username=="stress" && std::string_view(check.decryptPassword(e))=="secret:"+e.service) verified++;
+    }
+  }catch(const std::exception& e){
+    std::fprintf(stderr, "verify: %s\n", e.what());
+  }
+  std::string remove = "rm -rf '"+dir+"'";
+  if(std::system(remove.c_str())!=0) std::fprintf(stderr, "Couldn't remove %s\n", dir.c_str());
+  size_t total = processes*threads*ops;
+  std::printf("%d processes x %zu threads: %zu ops in %.2f s (%.0f ops/s), %zu/%zu entries verified, %d processes failed\n",
+              processes, threads, total, seconds, total/seconds, verified, expected, failedProcesses);
+  return failedProcesses==0 && verified==expected ? 0 : 1;
+}
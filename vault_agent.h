@@ -0,0 +1,469 @@
+// vault_agent.h
+#ifndef VAULT_AGENT_H
+#define VAULT_AGENT_H
+#include<string>
+#include<string_view>
+#include<vector>
+#include<unordered_map>
+#include<chrono>
+#include<stdexcept>
+#include<algorithm>
+#include<cerrno>
+#include<cstring>
+#include<cstdint>
+#include<csignal>
+#include<cstdlib>
+#include<sys/socket.h>
+#include<sys/un.h>
+#include<sys/stat.h>
+#include<sys/epoll.h>
+#include<sys/signalfd.h>
+#include<unistd.h>
+#include "password_storage.h"
+#include "secure_memory.h"
+
+// Wire format shared by the agent and its clients. Every message is a frame:
+//   u32 body length, then the body: u8 code, then zero or more fields (u32 length + bytes), little-endian.
+// Requests carry an opcode, responses a status. Frames and fields may hold passwords and live in SecureStrings.
+namespace AgentProtocol{
+  const size_t MAX_FRAME = 1<<20;      // Largest request the agent accepts
+  const size_t MAX_RESPONSE = 16<<20;  // Largest response a client accepts
+  const size_t LIST_PAGE = 512;        // Most entries per LIST response; LIST responses stay near MAX_FRAME bytes
+
+  enum Op : uint8_t{
+    GET = 1,      // service, username -> password
+    ADD = 2,      // service, username, password, notes
+    LIST = 3,     // offset -> entry count, then service, username, timestamp, notes for one page of entries
+    DELETE = 4,   // service, username
+    UNLOCK = 5,   // master password
+    LOCK = 6,
+    STATUS = 7    // -> "locked" or "unlocked", entry count
+  };
+
+  enum Status : uint8_t{
+    OK = 0,
+    ERROR = 1,    // message
+    LOCKED = 2    // The agent locked itself after being idle; send UNLOCK
+  };
+
+  struct Message{
+    uint8_t code = 0;
+    std::vector<SecureString> fields;
+  };
+
+  inline void put32(SecureString& out, uint32_t value){
+    for(int i=0; i<4; i++) out += static_cast<char>((value>>(8*i)) & 0xFF);
+  }
+
+  inline uint32_t get32(const char* p){
+    uint32_t value = 0;
+    for(int i=3; i>=0; i--) value = (value<<8) | static_cast<unsigned char>(p[i]);
+    return value;
+  }
+
+  // Appends one framed message to out
+  inline void appendFrame(SecureString& out, uint8_t code, const std::vector<std::string_view>& fields){
+    size_t body = 1;
+    for(auto field : fields) body += 4+field.size();
+    out.reserve(out.size()+4+body);
+    put32(out, body);
+    out += static_cast<char>(code);
+    for(auto field : fields){
+      put32(out, field.size());
+      out.append(field.data(), field.size());
+    }
+  }
+
+  // Parses a frame body (without its length prefix)
+  inline Message parseBody(const char* p, size_t size){
+    if(size<1) throw std::runtime_error("Empty agent message");
+    Message message;
+    message.code = static_cast<unsigned char>(*p);
+    size_t pos = 1;
+    while(pos<size){
+      if(size-pos<4) throw std::runtime_error("Truncated agent message");
+      uint32_t len = get32(p+pos);
+      pos += 4;
+      if(size-pos<len) throw std::runtime_error("Truncated agent message");
+      message.fields.emplace_back(p+pos, len);
+      pos += len;
+    }
+    return message;
+  }
+
+  // Socket path used when none is given: $XDG_RUNTIME_DIR/passanomix.sock, or one per user in /tmp
+  inline std::string defaultSocketPath(){
+    const char* runtime = std::getenv("XDG_RUNTIME_DIR");
+    if(runtime && *runtime) return std::string(runtime)+"/passanomix.sock";
+    return "/tmp/passanomix-"+std::to_string(::getuid())+".sock";
+  }
+
+  inline sockaddr_un socketAddress(const std::string& path){
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if(path.size()>=sizeof(addr.sun_path)){
+      throw std::runtime_error("Socket path too long: "+path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size()+1);
+    return addr;
+  }
+}
+
+// Keeps an unlocked, indexed vault resident and serves it over a Unix domain socket.
+// Single-threaded epoll loop with non-blocking connections; only peers running as the same user
+// are accepted. After idleSeconds without a request the vault is locked until a client sends UNLOCK.
+class VaultAgent{
+private:
+  // Per-connection buffers for partial frames in both directions
+  struct Connection{
+    SecureString in;
+    SecureString out;
+    size_t outPos = 0;
+  };
+
+  PasswordStorage& storage;
+  std::string socketPath;
+  int idleSeconds;
+  int listenFd = -1;
+  int epollFd = -1;
+  int signalFd = -1;
+  std::unordered_map<int, Connection> connections;
+  std::chrono::steady_clock::time_point lastActivity;
+
+  [[noreturn]] static void fail(const std::string& what){
+    throw std::runtime_error(what+": "+std::strerror(errno));
+  }
+
+  void watch(int fd, uint32_t events, int op=EPOLL_CTL_ADD){
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if(::epoll_ctl(epollFd, op, fd, &ev)!=0) fail("epoll_ctl failed");
+  }
+
+  void listenOnSocket(){
+    auto addr = AgentProtocol::socketAddress(socketPath);
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(listenFd<0) fail("Can't create socket");
+    struct stat st;
+    if(::lstat(socketPath.c_str(), &st)==0){
+      if(!S_ISSOCK(st.st_mode)) throw std::runtime_error(socketPath+" exists and is not a socket");
+      int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      bool live = probe>=0 && ::connect(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))==0;
+      if(probe>=0) ::close(probe);
+      if(live) throw std::runtime_error("An agent is already listening on "+socketPath);
+      ::unlink(socketPath.c_str());  // Left behind by an agent that didn't shut down cleanly
+    }
+    mode_t previous = ::umask(0077);  // Socket file only accessible to this user
+    int bound = ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::umask(previous);
+    if(bound!=0) fail("Can't bind "+socketPath);
+    if(::listen(listenFd, 128)!=0) fail("Can't listen on "+socketPath);
+  }
+
+  // Stops on SIGINT/SIGTERM by reading them from a descriptor in the event loop
+  void watchSignals(){
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    if(::sigprocmask(SIG_BLOCK, &mask, nullptr)!=0) fail("Can't block signals");
+    signalFd = ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if(signalFd<0) fail("Can't create signalfd");
+  }
+
+  // Accepts pending connections from the same user only
+  void acceptClients(){
+    while(true){
+      int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if(fd<0){
+        if(errno==EINTR) continue;
+        if(errno==EAGAIN || errno==EWOULDBLOCK) return;
+        fail("accept failed");
+      }
+      ucred peer{};
+      socklen_t len = sizeof(peer);
+      if(::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &peer, &len)!=0 || peer.uid!=::getuid()){
+        ::close(fd);
+        continue;
+      }
+      connections[fd];
+      watch(fd, EPOLLIN | EPOLLRDHUP);
+    }
+  }
+
+  void closeClient(int fd){
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+  }
+
+  static std::string_view field(const AgentProtocol::Message& request, size_t i){
+    return i<request.fields.size() ? std::string_view(request.fields[i]) : std::string_view();
+  }
+
+  // Runs one request against the vault and appends the response frame to out
+  void handle(const AgentProtocol::Message& request, SecureString& out){
+    using namespace AgentProtocol;
+    lastActivity = std::chrono::steady_clock::now();
+    try{
+      if(request.code==UNLOCK){
+        storage.unlock(field(request, 0));
+        appendFrame(out, OK, {});
+        return;
+      }
+      if(request.code==LOCK){
+        storage.lock();
+        appendFrame(out, OK, {});
+        return;
+      }
+      if(request.code==STATUS){
+        appendFrame(out, OK, {storage.isLocked() ? "locked" : "unlocked", std::to_string(storage.getEntryCount())});
+        return;
+      }
+      if(storage.isLocked()){
+        appendFrame(out, LOCKED, {"Vault is locked"});
+        return;
+      }
+      storage.refresh();  // Serve what other processes committed since the last request
+      std::string service(field(request, 0)), username(field(request, 1));
+      switch(request.code){
+        case GET:{
+          SecureString password = storage.getPassword(service, username);
+          appendFrame(out, OK, {password});
+          break;
+        }
+        case ADD:{
+          storage.addEntry(service, username, field(request, 2), std::string(field(request, 3)));
+          storage.commit();
+          appendFrame(out, OK, {});
+          break;
+        }
+        case LIST:{
+          // One page from the offset: at most LIST_PAGE entries, cut short once past MAX_FRAME bytes
+          PasswordStorage::ListQuery query;
+          std::string from(field(request, 0));
+          query.offset = from.empty() ? 0 : std::stoul(from);
+          query.limit = LIST_PAGE;
+          std::vector<std::string_view> fields(1);
+          fields.reserve(1+LIST_PAGE*4);
+          size_t bytes = 0;
+          std::string total = std::to_string(storage.listPage(query, [&](const EntryMeta& e){
+            if(bytes>MAX_FRAME) return;
+            bytes += e.service.size()+e.username.size()+e.timestamp.size()+e.notes.size()+16;
+            fields.insert(fields.end(), {e.service, e.username, e.timestamp, e.notes});
+          }));
+          fields[0] = total;
+          appendFrame(out, OK, fields);
+          break;
+        }
+        case DELETE:
+          if(!storage.deleteEntry(service, username)){
+            throw std::runtime_error("Entry not found");
+          }
+          storage.commit();
+          appendFrame(out, OK, {});
+          break;
+        default:
+          throw std::runtime_error("Unknown request "+std::to_string(request.code));
+      }
+    }catch(const std::exception& e){
+      appendFrame(out, ERROR, {e.what()});
+    }
+  }
+
+  // Writes as much pending output as the socket takes; returns false if the connection failed
+  bool flushClient(int fd, Connection& conn){
+    while(conn.outPos<conn.out.size()){
+      ssize_t n = ::send(fd, conn.out.data()+conn.outPos, conn.out.size()-conn.outPos, MSG_NOSIGNAL);
+      if(n<0){
+        if(errno==EINTR) continue;
+        if(errno==EAGAIN || errno==EWOULDBLOCK) break;
+        return false;
+      }
+      conn.outPos += n;
+    }
+    bool pending = conn.outPos<conn.out.size();
+    if(!pending){
+      conn.out.wipe();
+      conn.outPos = 0;
+    }
+    watch(fd, EPOLLIN | EPOLLRDHUP | (pending ? static_cast<uint32_t>(EPOLLOUT) : 0u), EPOLL_CTL_MOD);
+    return true;
+  }
+
+  // Reads available bytes and answers every complete frame; returns false when the client is gone or sends
+  // an oversized frame. At most one largest frame is buffered per call: the rest stays in the socket, and
+  // the level-triggered epoll calls again once these frames are answered.
+  bool readClient(int fd, Connection& conn){
+    char buf[16384];
+    while(conn.in.size()<=4+AgentProtocol::MAX_FRAME){
+      ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+      if(n<0){
+        if(errno==EINTR) continue;
+        if(errno==EAGAIN || errno==EWOULDBLOCK) break;
+        return false;
+      }
+      if(n==0) return false;
+      conn.in.append(buf, n);
+      if(conn.in.size()>=4 && AgentProtocol::get32(conn.in.data())>AgentProtocol::MAX_FRAME) return false;
+    }
+    OPENSSL_cleanse(buf, sizeof(buf));
+    size_t pos = 0;
+    while(conn.in.size()-pos>=4){
+      uint32_t len = AgentProtocol::get32(conn.in.data()+pos);
+      if(len>AgentProtocol::MAX_FRAME) return false;
+      if(conn.in.size()-pos-4<len) break;
+      try{
+        handle(AgentProtocol::parseBody(conn.in.data()+pos+4, len), conn.out);
+      }catch(const std::exception&){
+        return false;  // Malformed frame
+      }
+      OPENSSL_cleanse(&conn.in[pos], 4+len);  // Requests may carry passwords
+      pos += 4+len;
+    }
+    conn.in.erase(0, pos);
+    return flushClient(fd, conn);
+  }
+
+  // Milliseconds until the idle timeout, or -1 to wait indefinitely
+  int waitTimeout() const{
+    if(idleSeconds<=0 || storage.isLocked()) return -1;
+    auto deadline = lastActivity + std::chrono::seconds(idleSeconds);
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline-std::chrono::steady_clock::now()).count();
+    return left>0 ? static_cast<int>(std::min<long long>(left, 60000)) : 0;
+  }
+
+  void shutdown(){
+    for(auto& conn : connections) ::close(conn.first);
+    connections.clear();
+    if(listenFd>=0){
+      ::close(listenFd);
+      ::unlink(socketPath.c_str());
+    }
+    if(signalFd>=0) ::close(signalFd);
+    if(epollFd>=0) ::close(epollFd);
+    listenFd = signalFd = epollFd = -1;
+  }
+
+public:
+  VaultAgent(PasswordStorage& vault, const std::string& path, int idle) : storage(vault), socketPath(path), idleSeconds(idle){}
+
+  VaultAgent(const VaultAgent&) = delete;
+  VaultAgent& operator=(const VaultAgent&) = delete;
+
+  ~VaultAgent(){
+    shutdown();
+  }
+
+  // Serves requests until SIGINT or SIGTERM, then removes the socket and locks the vault
+  void run(){
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if(epollFd<0) fail("Can't create epoll instance");
+    listenOnSocket();
+    watchSignals();
+    watch(listenFd, EPOLLIN);
+    watch(signalFd, EPOLLIN);
+    lastActivity = std::chrono::steady_clock::now();
+    epoll_event events[64];
+    bool running = true;
+    while(running){
+      int n = ::epoll_wait(epollFd, events, 64, waitTimeout());
+      if(n<0){
+        if(errno==EINTR) continue;
+        fail("epoll_wait failed");
+      }
+      if(n==0 && waitTimeout()==0){
+        storage.lock();  // Idle timeout
+        continue;
+      }
+      for(int i=0; i<n; i++){
+        int fd = events[i].data.fd;
+        if(fd==signalFd){
+          running = false;
+        }else if(fd==listenFd){
+          acceptClients();
+        }else{
+          auto it = connections.find(fd);
+          if(it==connections.end()) continue;
+          bool ok = true;
+          if(events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) ok = readClient(fd, it->second);
+          else if(events[i].events & EPOLLOUT) ok = flushClient(fd, it->second);
+          if(!ok) closeClient(fd);
+        }
+      }
+    }
+    shutdown();
+    storage.lock();
+  }
+};
+
+// Blocking client for a running VaultAgent
+class AgentClient{
+private:
+  int fd = -1;
+
+  void sendAll(const SecureString& data){
+    size_t pos = 0;
+    while(pos<data.size()){
+      ssize_t n = ::send(fd, data.data()+pos, data.size()-pos, MSG_NOSIGNAL);
+      if(n<0){
+        if(errno==EINTR) continue;
+        throw std::runtime_error(std::string("Agent connection failed: ")+std::strerror(errno));
+      }
+      pos += n;
+    }
+  }
+
+  void recvAll(char* out, size_t size){
+    while(size>0){
+      ssize_t n = ::recv(fd, out, size, 0);
+      if(n<0 && errno==EINTR) continue;
+      if(n<=0) throw std::runtime_error("Agent closed the connection");
+      out += n;
+      size -= n;
+    }
+  }
+
+public:
+  explicit AgentClient(const std::string& path){
+    auto addr = AgentProtocol::socketAddress(path);
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(fd<0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))!=0){
+      int err = errno;
+      if(fd>=0) ::close(fd);
+      throw std::runtime_error("Can't connect to agent at "+path+": "+std::strerror(err));
+    }
+  }
+
+  AgentClient(const AgentClient&) = delete;
+  AgentClient& operator=(const AgentClient&) = delete;
+
+  ~AgentClient(){
+    if(fd>=0) ::close(fd);
+  }
+
+  // Sends one request and waits for its response
+  AgentProtocol::Message request(AgentProtocol::Op op, const std::vector<std::string_view>& fields={}){
+    SecureString frame;
+    AgentProtocol::appendFrame(frame, op, fields);
+    sendAll(frame);
+    char header[4];
+    recvAll(header, 4);
+    uint32_t length = AgentProtocol::get32(header);
+    if(length>AgentProtocol::MAX_RESPONSE) throw std::runtime_error("Agent response too large");
+    SecureString body(length, '\0');
+    recvAll(&body[0], body.size());
+    return AgentProtocol::parseBody(body.data(), body.size());
+  }
+
+  // Like request(), but throws the agent's message unless the status is OK
+  AgentProtocol::Message call(AgentProtocol::Op op, const std::vector<std::string_view>& fields={}){
+    AgentProtocol::Message response = request(op, fields);
+    if(response.code!=AgentProtocol::OK){
+      throw std::runtime_error(response.fields.empty() ? std::string("Agent request failed") : std::string(response.fields[0]));
+    }
+    return response;
+  }
+};
+#endif
@@ -0,0 +1,388 @@
+// vault_stream.h
+#ifndef VAULT_STREAM_H
+#define VAULT_STREAM_H
+#include<string>
+#include<string_view>
+#include<vector>
+#include<deque>
+#include<istream>
+#include<ostream>
+#include<streambuf>
+#include<memory>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<chrono>
+#include<functional>
+#include<exception>
+#include<stdexcept>
+#include<cstdio>
+#include<cstdint>
+#include "csv.h"
+#include "json_reader.h"
+#include "secure_memory.h"
+#include "password_storage.h"
+#include "parallel.h"
+
+// Streaming import and export as CSV (service,username,password,notes) or JSON Lines (one object per line
+// with the same keys). One thread parses or writes records in batches while worker threads encrypt or
+// decrypt the batch before it, and every imported batch is committed to the journal on its own, so memory
+// stays at a few batches however large the file is.
+class VaultStream{
+public:
+  enum Format{CSV, JSONL};
+
+  static constexpr size_t BATCH_SIZE = 4096;  // Records per batch, and per commit on import
+  static constexpr size_t QUEUE_DEPTH = 2;     // Batches buffered between the two stages
+
+  struct Result{
+    size_t records = 0;
+    uint64_t bytes = 0;  // Bytes read on import, written on export
+    double seconds = 0;
+
+    double recordsPerSecond() const{
+      return seconds>0 ? records/seconds : 0;
+    }
+
+    double megabytesPerSecond() const{
+      return seconds>0 ? bytes/1e6/seconds : 0;
+    }
+  };
+
+  // Parses "csv" or "jsonl" (also "ndjson")
+  static Format formatFromName(const std::string& name){
+    if(name=="csv") return CSV;
+    if(name=="jsonl" || name=="ndjson") return JSONL;
+    throw std::invalid_argument("Unknown format '"+name+"' (expected csv or jsonl)");
+  }
+
+  // JSON Lines for .jsonl and .ndjson files, CSV otherwise
+  static Format formatForPath(const std::string& path){
+    for(const char* ext : {".jsonl", ".ndjson"}){
+      size_t len = std::char_traits<char>::length(ext);
+      if(path.size()>=len && path.compare(path.size()-len, len, ext)==0) return JSONL;
+    }
+    return CSV;
+  }
+
+  // Appends str to out as a quoted JSON string
+  static void appendJsonString(SecureString& out, std::string_view str){
+    out += '"';
+    for(unsigned char c : str){
+      switch(c){
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+          if(c<0x20){
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+          }else{
+            out += c;
+          }
+      }
+    }
+    out += '"';
+  }
+
+  // Adds every record in `in` to store. A CSV header row is skipped. progress(result) runs after each commit.
+  // On a malformed record the batches before it stay committed and the error names the record.
+  static Result importFrom(PasswordStorage& store, std::istream& in, Format format, unsigned threads=0,
+                           std::function<void(const Result&)> progress=nullptr){
+    auto start = std::chrono::steady_clock::now();
+    store.unlock();
+    size_t existing = store.getEntryCount();
+    CountingInput counted(in.rdbuf());
+    std::istream input(&counted);
+    Channel<Batch> channel;
+    std::exception_ptr readError;
+    std::thread reader([&](){
+      try{
+        readBatches(input, format, channel);
+      }catch(...){
+        readError = std::current_exception();
+      }
+      channel.close();
+    });
+    if(threads==0) threads = Parallel::defaultThreads();
+    std::vector<std::unique_ptr<PasswordStorage::CryptoWorker>> workers;
+    for(unsigned i=0; i<threads; i++) workers.emplace_back(new PasswordStorage::CryptoWorker());
+    Result result;
+    try{
+      Batch batch;
+      std::vector<PasswordEntry> created;
+      while(channel.pop(batch)){
+        created.resize(batch.size());
+        Parallel::forChunks(batch.size(), threads, 256, [&](unsigned w, size_t begin, size_t end){
+          for(size_t i=begin; i<end; i++){
+            Row& row = batch[i];
+            created[i] = store.encryptEntry(*workers[w], row.service, row.username, row.password, row.notes);
+            row.password.wipe();
+          }
+        });
+        result.records += batch.size();
+        store.addEntries(created);
+        store.commit();
+        result.bytes = counted.count();
+        result.seconds = elapsed(start);
+        if(progress) progress(result);
+      }
+    }catch(...){
+      channel.close();  // Unblocks the reader
+      reader.join();
+      throw;
+    }
+    reader.join();
+    if(readError) std::rethrow_exception(readError);
+    // Most of the vault now lives in the journal; fold it into one snapshot so loading doesn't replay it
+    if(result.records>existing){
+      store.lockFile(true);
+      try{
+        store.refresh();  // Another process may have committed since the last batch
+        store.save();
+      }catch(...){
+        store.unlockFile();
+        throw;
+      }
+      store.unlockFile();
+    }
+    result.bytes = counted.count();
+    result.seconds = elapsed(start);
+    return result;
+  }
+
+  // Writes every entry with its decrypted password to out. progress(result) runs after each batch is written.
+  static Result exportTo(PasswordStorage& store, std::ostream& out, Format format, unsigned threads=0,
+                         std::function<void(const Result&)> progress=nullptr){
+    auto start = std::chrono::steady_clock::now();
+    store.unlock();
+    size_t count = store.getEntryCount();
+    Result result;
+    Channel<SecureString> channel;
+    std::exception_ptr writeError;
+    std::thread writer([&](){
+      try{
+        SecureString chunk;
+        while(channel.pop(chunk)){
+          out.write(chunk.data(), chunk.size());
+          if(!out) throw std::runtime_error("Export write failed");
+          chunk.wipe();
+        }
+        out.flush();
+        if(!out) throw std::runtime_error("Export write failed");
+      }catch(...){
+        writeError = std::current_exception();
+        channel.close();  // Unblocks the decrypting stage
+      }
+    });
+    if(threads==0) threads = Parallel::defaultThreads();
+    std::vector<std::unique_ptr<PasswordStorage::CryptoWorker>> workers;
+    for(unsigned i=0; i<threads; i++) workers.emplace_back(new PasswordStorage::CryptoWorker());
+    try{
+      if(format==CSV){
+        SecureString header = Csv::formatRecord<SecureString>({"service", "username", "password", "notes"});
+        result.bytes += header.size();
+        channel.push(std::move(header));
+      }
+      std::vector<SecureString> lines(std::min(count, BATCH_SIZE));
+      for(size_t first=0; first<count; first+=BATCH_SIZE){
+        size_t n = std::min(BATCH_SIZE, count-first);
+        Parallel::forChunks(n, threads, 256, [&](unsigned w, size_t begin, size_t end){
+          size_t i = begin;
+          store.openEntries(*workers[w], first+begin, first+end, [&](const PasswordEntry& e, const SecureString& password){
+            formatRecord(lines[i++], format, e, password);
+          });
+        });
+        SecureString chunk;
+        size_t total = 0;
+        for(size_t i=0; i<n; i++) total += lines[i].size();
+        chunk.reserve(total);
+        for(size_t i=0; i<n; i++){
+          chunk += lines[i];
+          lines[i].wipe();
+        }
+        if(!channel.push(std::move(chunk))) break;  // The writer failed
+        result.records += n;
+        result.bytes += total;
+        result.seconds = elapsed(start);
+        if(progress) progress(result);
+      }
+    }catch(...){
+      channel.close();
+      writer.join();
+      throw;
+    }
+    channel.close();
+    writer.join();
+    if(writeError) std::rethrow_exception(writeError);
+    result.seconds = elapsed(start);
+    return result;
+  }
+
+private:
+  struct Row{
+    std::string service, username, notes;
+    SecureString password;
+  };
+  using Batch = std::vector<Row>;
+
+  // Bounded queue between a producer and a consumer thread. close() wakes both sides: push then fails,
+  // and pop drains what is queued before failing.
+  template<typename T>
+  class Channel{
+  private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<T> items;
+    bool closed = false;
+
+  public:
+    bool push(T&& item){
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&](){ return closed || items.size()<QUEUE_DEPTH; });
+      if(closed) return false;
+      items.push_back(std::move(item));
+      changed.notify_all();
+      return true;
+    }
+
+    bool pop(T& item){
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&](){ return closed || !items.empty(); });
+      if(items.empty()) return false;
+      item = std::move(items.front());
+      items.pop_front();
+      changed.notify_all();
+      return true;
+    }
+
+    void close(){
+      std::lock_guard<std::mutex> lock(mutex);
+      closed = true;
+      changed.notify_all();
+    }
+  };
+
+  // Input buffer that counts the bytes read through it. The buffer is secure memory, since it holds
+  // plaintext passwords on their way to the parser.
+  class CountingInput : public std::streambuf{
+  private:
+    std::streambuf* source;
+    SecureBytes buffer;
+    uint64_t total = 0;
+
+  protected:
+    int_type underflow() override{
+      std::streamsize n = source->sgetn(reinterpret_cast<char*>(buffer.data()), buffer.size());
+      if(n<=0) return traits_type::eof();
+      total += n;
+      char* base = reinterpret_cast<char*>(buffer.data());
+      setg(base, base, base+n);
+      return traits_type::to_int_type(*base);
+    }
+
+  public:
+    explicit CountingInput(std::streambuf* src) : source(src), buffer(64*1024){}
+
+    uint64_t count() const{
+      return total;
+    }
+  };
+
+  static double elapsed(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+  }
+
+  // Parses in into batches of BATCH_SIZE rows and hands them to channel, stopping early if it is closed
+  static void readBatches(std::istream& in, Format format, Channel<Batch>& channel){
+    Batch batch;
+    batch.reserve(BATCH_SIZE);
+    std::vector<SecureString> fields;
+    SecureString line;
+    size_t record = 0;
+    while(true){
+      Row row;
+      if(format==CSV){
+        if(!Csv::readRecord(in, fields)) break;
+        record++;
+        if(fields.size()==1 && fields[0].empty()) continue;
+        if(record==1 && fields.size()>=3 && fields[0]=="service" && fields[1]=="username") continue;
+        if(fields.size()<3 || fields.size()>4){
+          throw std::runtime_error("Import record "+std::to_string(record)+": expected service,username,password[,notes]");
+        }
+        row.service = std::string(fields[0]);
+        row.username = std::string(fields[1]);
+        row.password = std::move(fields[2]);
+        if(fields.size()>3) row.notes = std::string(fields[3]);
+      }else{
+        if(!std::getline(in, line)) break;
+        record++;
+        if(line.find_first_not_of(" \t\r")==SecureString::npos) continue;
+        parseJsonRecord(line, record, row);
+      }
+      batch.push_back(std::move(row));
+      if(batch.size()==BATCH_SIZE){
+        if(!channel.push(std::move(batch))) return;
+        batch = Batch();
+        batch.reserve(BATCH_SIZE);
+      }
+    }
+    if(!batch.empty()) channel.push(std::move(batch));
+  }
+
+  // Reads {"service", "username", "password", "notes"} from one JSON line; other keys are ignored
+  static void parseJsonRecord(const SecureString& line, size_t record, Row& row){
+    std::string context = "Import record "+std::to_string(record);
+    JsonReader reader(line.data(), line.size(), context.c_str());
+    bool hasService = false, hasPassword = false;
+    reader.beginObject();
+    std::string_view key;
+    while(reader.nextKey(key)){
+      if(key=="service"){
+        reader.readString(row.service);
+        hasService = true;
+      }else if(key=="username"){
+        reader.readString(row.username);
+      }else if(key=="password"){
+        reader.readString(row.password);
+        hasPassword = true;
+      }else if(key=="notes"){
+        reader.readString(row.notes);
+      }else{
+        reader.skipValue();
+      }
+    }
+    if(!hasService || !hasPassword){
+      throw std::runtime_error(context+": expected \"service\" and \"password\" keys");
+    }
+  }
+
+  // Formats one exported record, reusing line's buffer
+  static void formatRecord(SecureString& line, Format format, const PasswordEntry& e, const SecureString& password){
+    line.wipe();
+    if(format==CSV){
+      Csv::appendField(line, e.service);
+      line += ',';
+      Csv::appendField(line, e.username);
+      line += ',';
+      Csv::appendField(line, password);
+      line += ',';
+      Csv::appendField(line, e.notes);
+    }else{
+      line += "{\"service\": ";
+      appendJsonString(line, e.service);
+      line += ", \"username\": ";
+      appendJsonString(line, e.username);
+      line += ", \"password\": ";
+      appendJsonString(line, password);
+      line += ", \"notes\": ";
+      appendJsonString(line, e.notes);
+      line += '}';
+    }
+    line += '\n';
+  }
+};
+#endif
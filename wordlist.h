@@ -0,0 +1,814 @@
+// wordlist.h
+#ifndef WORDLIST_H
+#define WORDLIST_H
+#include<string_view>
+#include<iterator>
+#include<cstddef>
+
+// Built-in passphrase wordlist: 7,776 common English words of 3 to 9 letters (the size of a five-dice
+// list, 12.9 bits per word), chosen to be easy to spell and remember and checked against a dictionary.
+// Words are unique, lowercase and sorted, which the static_assert below enforces. Passphrases mark every
+// word boundary (with a separator that has no letters, or with title case), so one splits back into its
+// words one way only and its entropy is exactly words x log2(SIZE).
+namespace Wordlist{
+  inline constexpr std::string_view WORDS[] = {
+    "abacus", "abandon", "abbey", "abdomen", "abide", "ability", "ablaze", "able", "aboard", "abolish",
+    "abound", "about", "above", "abrasive", "abridge", "abroad", "abrupt", "absence", "absent", "absentee",
+    "absolute", "absolve", "absorb", "absorbent", "abstain", "abstract", "absurd", "abundance", "abundant",
+    "abysmal", "academic", "academy", "accent", "accept", "access", "accessory", "accident", "acclaim",
+    "acclaimed", "acclimate", "accompany", "accord", "accordion", "account", "accrue", "accuracy", "accurate",
+    "accuse", "accused", "ace", "acetone", "ache", "achieve", "aching", "acid", "acidic", "acorn", "acoustic",
+    "acoustics", "acquaint", "acquire", "acre", "acreage", "acrobat", "acronym", "across", "acrylic", "act",
+    "acting", "action", "activate", "active", "actively", "activist", "activity", "actor", "actress", "actual",
+    "actually", "acute", "adamant", "adapt", "adaptive", "add", "added", "addendum", "adding", "addition",
+    "address", "addressee", "adept", "adequate", "adhere", "adhesive", "adjacent", "adjective", "adjoin",
+    "adjoining", "adjourn", "adjust", "admirable", "admiral", "admire", "admirer", "admit", "adobe", "adopt",
+    "adoption", "adorable", "adore", "adorn", "adorned", "adrift", "adult", "advance", "advantage", "advent",
+    "adventure", "adverb", "adverse", "advertise", "advice", "advise", "advisor", "advocate", "aerial",
+    "aerobic", "aerobics", "aerosol", "affable", "affair", "affect", "affection", "affirm", "affluent",
+    "afford", "afield", "afloat", "afoot", "afraid", "afresh", "after", "afterglow", "afterlife", "aftermath",
+    "afternoon", "afterward", "afterword", "again", "age", "aged", "agency", "agenda", "agent", "aggregate",
+    "agile", "aging", "agitate", "agony", "agree", "agreeable", "agreeably", "agreed", "agreement", "ahead",
+    "aid", "aide", "ailment", "aim", "aimless", "aimlessly", "air", "airbag", "airbase", "airborne", "airbrush",
+    "airbus", "aircraft", "airdrop", "airfare", "airfield", "airfoil", "airless", "airlift", "airline",
+    "airlock", "airmail", "airplane", "airport", "airship", "airspace", "airspeed", "airstrip", "airtight",
+    "airway", "airy", "aisle", "ajar", "akin", "alabaster", "alarm", "alarming", "albatross", "albino", "album",
+    "alchemy", "alcove", "alder", "ale", "alert", "alertness", "alfalfa", "algae", "algebra", "algebraic",
+    "algorithm", "alias", "alibi", "alien", "align", "alignment", "alike", "alive", "alkaline", "all",
+    "allergy", "alley", "alliance", "allied", "alligator", "allocate", "allot", "allotment", "allow",
+    "allowance", "alloy", "allspice", "ally", "almanac", "almighty", "almond", "almost", "aloe", "aloft",
+    "alone", "along", "alongside", "aloof", "aloud", "alpaca", "alpha", "alphabet", "alpine", "already", "also",
+    "altar", "alter", "alterable", "although", "altitude", "alto", "alumni", "always", "amateur", "amaze",
+    "amazing", "amazon", "amber", "ambience", "ambient", "ambition", "ambitious", "ambulance", "ambush",
+    "amend", "amends", "amenity", "amethyst", "amiable", "amid", "amiss", "ammonia", "amnesty", "amoeba",
+    "among", "amount", "amp", "ample", "amplifier", "amplify", "amulet", "amuse", "amusement", "amusing",
+    "anaconda", "anagram", "analog", "analysis", "analyst", "analyze", "anatomy", "ancestor", "ancestry",
+    "anchor", "anchorman", "anchovy", "ancient", "android", "anecdote", "anemone", "anew", "angel", "angelic",
+    "anger", "angle", "angler", "angora", "angry", "anguish", "animal", "animate", "animation", "ankle",
+    "anklebone", "anklet", "annex", "annexed", "annotate", "announce", "annoy", "annual", "annually",
+    "anointed", "anorak", "another", "answer", "ant", "anteater", "antelope", "antenna", "anthem", "anthill",
+    "anthology", "antibody", "antidote", "antique", "antiques", "antiquity", "antiviral", "antler", "antonym",
+    "anvil", "anxiety", "anxious", "any", "anybody", "anyhow", "anyone", "anyplace", "anything", "anytime",
+    "anyway", "anywhere", "apart", "apartment", "aperture", "apex", "apiary", "aplomb", "apology", "apostle",
+    "apparel", "apparent", "appeal", "appear", "appease", "append", "appendix", "appetite", "appetizer",
+    "applaud", "applause", "apple", "appliance", "applicant", "apply", "appoint", "appraisal", "approach",
+    "approval", "approve", "apricot", "apron", "apt", "aptitude", "aqua", "aquarium", "aquatic", "aqueduct",
+    "arbitrary", "arbor", "arboreal", "arcade", "arcane", "arch", "archangel", "archer", "archery", "architect",
+    "archive", "archivist", "archway", "arctic", "ardent", "ardor", "area", "arena", "arguably", "argue",
+    "arid", "arise", "arm", "armada", "armband", "armchair", "armful", "armistice", "armload", "armor",
+    "armored", "armpit", "armrest", "army", "aroma", "aromatic", "arose", "around", "arousal", "arrange",
+    "array", "arrest", "arrival", "arrive", "arrogant", "arrow", "arrowhead", "arsenal", "art", "artery",
+    "artful", "artfully", "artichoke", "article", "artifact", "artisan", "artist", "artistic", "artwork",
+    "ascend", "ascension", "ascent", "ascetic", "ash", "ashamed", "ashen", "ashore", "ashtray", "aside", "ask",
+    "asleep", "asparagus", "aspect", "aspen", "asphalt", "aspire", "aspirin", "assemble", "assembly", "assert",
+    "assess", "asset", "assign", "assist", "assistant", "assorted", "assume", "assurance", "assure", "asterisk",
+    "asteroid", "astonish", "astound", "astride", "astrology", "astronaut", "astronomy", "astute", "athlete",
+    "athletic", "atlas", "atom", "atomic", "atrium", "attach", "attack", "attain", "attempt", "attend",
+    "attendant", "attendee", "attention", "attentive", "attest", "attic", "attire", "attitude", "attorney",
+    "attract", "attractor", "attribute", "auburn", "auction", "audible", "audience", "audio", "audit",
+    "audition", "auditor", "augment", "august", "aunt", "aura", "auspice", "austere", "authentic", "author",
+    "auto", "autograph", "automatic", "autopilot", "autumn", "autumnal", "avail", "available", "avalanche",
+    "avatar", "avenge", "avenue", "average", "avert", "aviary", "aviation", "aviator", "avid", "avionics",
+    "avocado", "avoid", "await", "awake", "awaken", "awakening", "award", "aware", "away", "awe", "awesome",
+    "awestruck", "awful", "awhile", "awkward", "awning", "axe", "axiom", "axis", "axle", "azalea", "azure",
+    "babble", "baboon", "baby", "babysit", "bachelor", "back", "backache", "backboard", "backbone", "backdoor",
+    "backdrop", "backer", "backfield", "backfire", "backhand", "backhoe", "backing", "backlash", "backlit",
+    "backlog", "backpack", "backrest", "backroom", "backside", "backslash", "backspace", "backspin",
+    "backstage", "backstory", "backtrack", "backup", "backward", "backwater", "backwoods", "backyard", "bacon",
+    "bacteria", "bad", "badge", "badger", "badlands", "badly", "badminton", "baffle", "bag", "bagel", "bagful",
+    "baggage", "baggy", "bagpipe", "bagpiper", "bagpipes", "baguette", "bailiff", "bailout", "bait", "bake",
+    "baked", "baker", "bakery", "bakeshop", "bakeware", "baking", "balance", "balancing", "balcony", "bald",
+    "bale", "ball", "ballad", "ballast", "ballerina", "ballet", "ballgame", "balloon", "ballot", "ballpark",
+    "ballpoint", "ballroom", "balm", "balmy", "balsa", "balsam", "balsamic", "bamboo", "ban", "banana", "band",
+    "bandage", "bandanna", "bandit", "bandstand", "bandwagon", "bang", "bangle", "banish", "banister", "banjo",
+    "bank", "bankbook", "bankcard", "banker", "banking", "bankroll", "banner", "banquet", "banshee", "banter",
+    "baptism", "bar", "barb", "barbecue", "barbell", "barber", "barcode", "bare", "bareback", "barefaced",
+    "barefoot", "barely", "bargain", "barge", "baritone", "bark", "barley", "barn", "barnacle", "barnstorm",
+    "barnyard", "barometer", "baron", "barracks", "barracuda", "barrel", "barren", "barrette", "barricade",
+    "barrier", "barstool", "bartender", "barter", "basalt", "base", "baseball", "baseboard", "baseline",
+    "basement", "bashful", "basic", "basil", "basin", "basis", "basket", "basketful", "basketry", "bass",
+    "bassoon", "bastion", "bat", "batch", "bath", "bathhouse", "bathmat", "bathrobe", "bathroom", "bathtub",
+    "bathwater", "baton", "battalion", "batten", "batter", "battery", "battle", "bauble", "bay", "bayou",
+    "bazaar", "beach", "beachhead", "beacon", "bead", "beadwork", "beagle", "beak", "beam", "bean", "beanbag",
+    "beanie", "beanpole", "beanstalk", "bear", "bearable", "beard", "bearer", "bearing", "bearskin", "beast",
+    "beat", "beaten", "beating", "beatnik", "beautify", "beauty", "beaver", "became", "beckon", "beckoning",
+    "become", "bed", "bedazzle", "bedazzled", "bedbug", "bedding", "bedpost", "bedrock", "bedroll", "bedroom",
+    "bedside", "bedspread", "bedtime", "bee", "beech", "beef", "beehive", "beekeeper", "beep", "beeswax",
+    "beet", "beetle", "befall", "befit", "before", "befriend", "beg", "began", "begin", "beginner", "beginning",
+    "beguile", "begun", "behalf", "behave", "behemoth", "behind", "behold", "beige", "being", "belated",
+    "belch", "belfry", "belief", "believe", "believer", "bell", "bellboy", "bellhop", "bellow", "belly",
+    "belong", "belonging", "beloved", "below", "belt", "beltway", "bemused", "bench", "benchmark", "benchwork",
+    "bend", "beneath", "benefit", "benign", "bent", "bequest", "berate", "beret", "berry", "berserk", "beseech",
+    "beside", "best", "bestow", "bet", "betray", "betroth", "better", "between", "beverage", "beware",
+    "bewilder", "beyond", "bias", "biathlon", "bib", "bicker", "bicycle", "bid", "bidder", "biennial",
+    "bifocal", "big", "bigwig", "bike", "biker", "bikini", "bilingual", "bill", "billboard", "billfold",
+    "billiards", "billion", "billow", "bin", "binary", "bind", "binder", "binding", "bingo", "binocular",
+    "biography", "biology", "biplane", "birch", "bird", "birdbath", "birdcage", "birdhouse", "birdie",
+    "birdseed", "birdsong", "birth", "birthday", "birthmark", "birthrate", "biscuit", "bisect", "bishop",
+    "bison", "bistro", "bit", "bite", "biting", "bitmap", "bitter", "bitterly", "bizarre", "black", "blackbird",
+    "blacken", "blacklist", "blackout", "blacktop", "blade", "blame", "blameless", "bland", "blandly", "blank",
+    "blanket", "blast", "blaze", "blazer", "blazing", "bleach", "bleacher", "bleachers", "blend", "blender",
+    "bless", "blessed", "blessing", "blew", "blimp", "blind", "blindfold", "blindness", "blink", "blinker",
+    "bliss", "blissful", "blister", "blithe", "blizzard", "bloat", "block", "blockade", "blog", "blond",
+    "blood", "bloom", "blooming", "blossom", "blot", "blotch", "blotter", "blouse", "blow", "blower", "blown",
+    "blowout", "blowtorch", "blubber", "blue", "bluebell", "blueberry", "bluebird", "bluegrass", "blueprint",
+    "bluff", "blunder", "blunt", "blur", "blurry", "blush", "board", "boarding", "boardroom", "boardwalk",
+    "boast", "boastful", "boat", "boathouse", "boating", "boatload", "bobbin", "bobcat", "bobsled", "bobtail",
+    "bobwhite", "bodice", "body", "bodyguard", "bodysuit", "bodywork", "bogey", "boggle", "bogus", "boil",
+    "boiler", "bold", "bolster", "bolt", "bombast", "bonanza", "bonbon", "bond", "bone", "bonehead", "bonfire",
+    "bongo", "bonnet", "bonnie", "bonsai", "bonus", "bony", "book", "bookcase", "bookend", "bookish", "booklet",
+    "bookmark", "bookplate", "bookshelf", "bookshop", "bookstore", "bookworm", "boom", "boomerang", "boost",
+    "boot", "booth", "bootlace", "bootleg", "bootstrap", "boozy", "border", "bore", "boredom", "boring", "born",
+    "borrow", "borrower", "boss", "botanist", "botany", "both", "bother", "bottle", "bottom", "bought",
+    "boulder", "boulevard", "bounce", "bound", "boundary", "boundless", "bountiful", "bounty", "bouquet",
+    "bout", "boutique", "bovine", "bow", "bowl", "bowler", "bowling", "box", "boxcar", "boxer", "boxing",
+    "boxlike", "boxwood", "boy", "boycott", "brace", "bracelet", "bracket", "brag", "braid", "brain", "brainy",
+    "brake", "bramble", "bran", "branch", "brand", "brandish", "brass", "brasserie", "bravado", "brave",
+    "bravery", "bravo", "brawl", "brazen", "bread", "breadbox", "breadth", "break", "breakable", "breakaway",
+    "breakdown", "breaker", "breakfast", "breakout", "breakup", "breath", "breathe", "breathing", "breed",
+    "breeder", "breeze", "breezeway", "breezy", "brethren", "brew", "brewery", "briar", "brick", "brickwork",
+    "brickyard", "bridal", "bride", "bridge", "bridle", "brief", "briefcase", "brigade", "bright", "brightly",
+    "brilliant", "brim", "brimstone", "brine", "bring", "brink", "brioche", "briquette", "brisk", "bristle",
+    "brittle", "broad", "broadband", "broadcast", "broadly", "broadside", "broccoli", "brochure", "broil",
+    "broke", "broken", "broker", "bronco", "bronze", "brooch", "brooding", "brook", "broom", "broth", "brother",
+    "brotherly", "brought", "brow", "brown", "brownie", "brownish", "browse", "browsing", "bruise", "brunch",
+    "brunette", "brush", "brusque", "brutal", "bubble", "buccaneer", "buckboard", "bucket", "buckeye", "buckle",
+    "buckshot", "buckskin", "buckwheat", "bud", "buddy", "budge", "budget", "buffalo", "buffer", "buffering",
+    "buffet", "bug", "buggy", "bugle", "build", "builder", "building", "buildup", "built", "bulb", "bulge",
+    "bulk", "bulkhead", "bull", "bulldog", "bulldozer", "bullet", "bulletin", "bullfinch", "bullfrog",
+    "bullhorn", "bullion", "bullpen", "bullring", "bullseye", "bulwark", "bumblebee", "bump", "bumper", "bumpy",
+    "bun", "bunch", "bundle", "bungalow", "bunk", "bunker", "bunny", "bunting", "buoy", "buoyant", "burden",
+    "bureau", "burger", "burial", "buried", "burlap", "burly", "burn", "burner", "burnish", "burnt", "burrito",
+    "burrow", "bursar", "burst", "bury", "bus", "busboy", "bush", "bushel", "busily", "business", "bustle",
+    "busy", "busybody", "butler", "butter", "buttercup", "butterfly", "buttery", "button", "buttress", "buy",
+    "buyer", "buzz", "buzzard", "buzzer", "buzzword", "bygone", "bypass", "bystander", "byte", "cab", "cabana",
+    "cabbage", "cabdriver", "cabin", "cabinet", "cabinetry", "cable", "caboose", "cackle", "cactus", "cadence",
+    "cadet", "cadmium", "cafe", "cage", "cajole", "cake", "cakewalk", "calamity", "calcium", "calculate",
+    "calculus", "calendar", "calf", "caliber", "calibrate", "calico", "caliper", "call", "callous", "calm",
+    "calmly", "calorie", "camcorder", "camel", "camellia", "cameo", "camera", "camisole", "camp", "campaign",
+    "camper", "campfire", "camping", "campsite", "campus", "can", "canal", "canary", "cancel", "candid",
+    "candidate", "candle", "candlelit", "candor", "candy", "cane", "canine", "canister", "canned", "cannery",
+    "cannon", "canoe", "canoeing", "canoeist", "canola", "canopy", "canteen", "canter", "canvas", "canyon",
+    "cap", "capable", "capacitor", "capacity", "cape", "caper", "capital", "capstone", "capsule", "captain",
+    "caption", "captivate", "captive", "capture", "car", "carafe", "caramel", "caravan", "carbon", "card",
+    "cardboard", "cardigan", "cardinal", "care", "careen", "career", "carefree", "careful", "carefully",
+    "caregiver", "careless", "caress", "caretaker", "cargo", "caring", "carload", "carnation", "carnival",
+    "carol", "carolers", "carousel", "carpenter", "carpet", "carpool", "carport", "carriage", "carrier",
+    "carrot", "carry", "carsick", "cart", "cartel", "cartload", "cartoon", "cartridge", "cartwheel", "carve",
+    "carving", "cascade", "case", "cash", "cashew", "cashier", "cashmere", "casino", "casserole", "cast",
+    "castanet", "castaway", "castle", "castoff", "casual", "cat", "catacomb", "catalog", "catalyst",
+    "catamaran", "catapult", "cataract", "catbird", "catcall", "catch", "catchall", "catchy", "category",
+    "cater", "caterer", "catfish", "cathedral", "catnap", "catnip", "cattail", "cattle", "catwalk", "caucus",
+    "caught", "cauldron", "cause", "causeway", "caution", "cautious", "cavalier", "cavalry", "cave", "cavern",
+    "caviar", "cavity", "cease", "ceasefire", "cedar", "ceiling", "celebrate", "celebrity", "celery",
+    "celestial", "cell", "cellar", "cellist", "cello", "cellphone", "cement", "census", "cent", "centaur",
+    "center", "centipede", "central", "century", "ceramic", "ceramics", "cereal", "ceremony", "certain",
+    "certainly", "certify", "chaff", "chagrin", "chain", "chainsaw", "chair", "chairlift", "chairman", "chalet",
+    "chalice", "chalk", "challenge", "chamber", "chameleon", "chamomile", "champagne", "champion", "chance",
+    "change", "channel", "chant", "chapel", "chaperone", "chaplain", "chaplet", "chapter", "charade",
+    "charcoal", "charge", "chariot", "charisma", "charity", "charm", "charmer", "charming", "chart", "charter",
+    "chase", "chasm", "chastise", "chat", "chateau", "chatter", "chauffeur", "cheap", "cheat", "check",
+    "checkbook", "checkers", "checklist", "checkmate", "checkup", "cheddar", "cheek", "cheekbone", "cheer",
+    "cheerful", "cheering", "cheese", "cheetah", "chef", "chemical", "chemist", "chemistry", "chenille",
+    "cherish", "cherished", "cherry", "chervil", "chess", "chest", "chestnut", "chew", "chick", "chickadee",
+    "chicken", "chickpea", "chief", "chiffon", "child", "childhood", "chili", "chill", "chilly", "chime",
+    "chimney", "chimp", "chin", "china", "chinaware", "chinstrap", "chip", "chipboard", "chipmunk", "chipper",
+    "chirp", "chirpy", "chisel", "chivalry", "chive", "chloride", "chlorine", "chocolate", "choice", "choir",
+    "choke", "choose", "chop", "chopping", "chopstick", "choral", "chord", "chore", "chortle", "chorus",
+    "chose", "chosen", "chowder", "chrome", "chromium", "chronic", "chronicle", "chubby", "chuckle", "chunk",
+    "church", "churn", "chutney", "cicada", "cider", "cinder", "cinema", "cinnamon", "cipher", "circle",
+    "circlet", "circuit", "circular", "circus", "citadel", "citation", "citizen", "citrus", "city", "citywide",
+    "civic", "civil", "civilian", "civility", "civilized", "claim", "clam", "clambake", "clamber", "clammy",
+    "clamp", "clan", "clap", "clapboard", "clarify", "clarinet", "clarion", "clarity", "clash", "clasp",
+    "class", "classic", "classical", "classify", "classmate", "classroom", "clatter", "clause", "claw", "clay",
+    "clean", "cleaner", "cleanly", "cleanse", "cleanup", "clear", "clearance", "clearing", "clearway",
+    "cleaver", "clergy", "clerk", "clever", "click", "client", "cliff", "climate", "climb", "climber",
+    "clincher", "cling", "clinic", "clip", "clipboard", "clipper", "cloak", "cloakroom", "clock", "clockwork",
+    "clog", "cloister", "close", "closet", "closure", "cloth", "clothes", "clothier", "clothing", "cloud",
+    "cloudless", "cloudy", "clove", "clover", "clown", "club", "clubhouse", "clue", "clumsy", "cluster",
+    "clutch", "coach", "coal", "coalition", "coalmine", "coast", "coastal", "coaster", "coastline", "coat",
+    "coatroom", "coaxial", "cobalt", "cobbler", "cobra", "cobweb", "cockatoo", "cockpit", "cocoa", "coconut",
+    "cod", "code", "codfish", "coexist", "coffee", "coffeepot", "cogwheel", "cohort", "coiffure", "coil",
+    "coin", "colander", "cold", "coleslaw", "coleus", "collage", "collapse", "collar", "colleague", "collect",
+    "collector", "college", "collide", "collie", "colon", "colonel", "colonial", "colony", "color", "colorful",
+    "colossal", "colossus", "columbine", "column", "comb", "combat", "combine", "come", "comeback", "comebacks",
+    "comedian", "comedy", "comely", "comet", "comfort", "comforter", "comfy", "comic", "coming", "comma",
+    "command", "commando", "commend", "comment", "commerce", "commodore", "common", "commotion", "communal",
+    "commune", "commuter", "compact", "compactly", "compactor", "company", "compare", "compass", "compel",
+    "compete", "compile", "complain", "complete", "complex", "compliant", "comply", "compose", "composed",
+    "composer", "compost", "composure", "compound", "comprise", "computer", "comrade", "concave", "conceal",
+    "concede", "concept", "concern", "concert", "concerto", "concierge", "conclave", "conclude", "concourse",
+    "concrete", "condiment", "condone", "condor", "conduct", "conductor", "conduit", "cone", "confess",
+    "confetti", "confide", "confident", "confine", "confirm", "conflict", "confront", "confuse", "conga",
+    "congrats", "congress", "conifer", "conjure", "connect", "connector", "conquer", "consensus", "consent",
+    "conserve", "consider", "console", "consonant", "consort", "constable", "constant", "construct", "consult",
+    "consume", "contact", "contain", "container", "contend", "content", "contented", "contest", "context",
+    "continue", "contort", "contour", "contract", "contrast", "control", "convene", "convent", "convert",
+    "converter", "convey", "conveyor", "convince", "convoy", "cook", "cookbook", "cookie", "cooking", "cookout",
+    "cookware", "cool", "coolant", "cooler", "cooper", "cope", "copilot", "copious", "copper", "copy",
+    "copycat", "copyright", "coral", "cord", "cordial", "cordless", "corduroy", "core", "coriander", "cork",
+    "corn", "cornbread", "cornea", "corner", "cornfield", "cornflake", "cornice", "cornmeal", "cornstalk",
+    "corolla", "corona", "coronet", "corporal", "corporate", "correct", "corridor", "corset", "cosmetic",
+    "cosmic", "cosmos", "cost", "costly", "costume", "cottage", "cotton", "couch", "cougar", "cough", "could",
+    "council", "count", "countdown", "counter", "countless", "country", "county", "couple", "couplet", "coupon",
+    "courage", "courier", "course", "court", "courtroom", "courtship", "courtyard", "cousin", "couture", "cove",
+    "covenant", "cover", "coverall", "covet", "cow", "cowbell", "cowboy", "cowgirl", "cowhand", "cowlick",
+    "coworker", "coyote", "cozy", "crab", "crack", "crackdown", "cracker", "cradle", "craft", "craftsman",
+    "crafty", "cram", "cramp", "cranberry", "crane", "crank", "crash", "crate", "crater", "crave", "crawl",
+    "crayfish", "crayon", "crazy", "creak", "cream", "creamery", "create", "creation", "creative", "creature",
+    "credence", "credit", "credo", "creek", "creekside", "creep", "crescent", "crest", "crevice", "crew",
+    "crib", "cribbage", "cricket", "cricketer", "crimson", "crinkle", "crisp", "critic", "critique", "crochet",
+    "crockery", "crocodile", "crocus", "croissant", "crop", "cross", "crossbar", "crossbow", "crossfire",
+    "crossover", "crossroad", "crosstown", "crosswalk", "crossword", "crouch", "crouton", "crow", "crowbar",
+    "crowd", "crowdfund", "crown", "crucial", "crucible", "crude", "cruise", "cruiser", "crumb", "crumble",
+    "crunch", "crusade", "crusader", "crush", "crust", "crutch", "cry", "cryptic", "crystal", "cub", "cube",
+    "cubicle", "cuckoo", "cucumber", "cuddle", "cue", "cuff", "cufflink", "cuisine", "cultural", "culture",
+    "culvert", "cumin", "cup", "cupboard", "cupcake", "cupful", "cupola", "curator", "curb", "curbside", "cure",
+    "curfew", "curiosity", "curious", "curl", "curly", "currant", "currency", "current", "curry", "cursive",
+    "cursor", "curtain", "curve", "cushion", "cushioned", "custard", "custodian", "custom", "customer",
+    "customize", "cut", "cutback", "cute", "cutlass", "cutlery", "cutout", "cycle", "cyclist", "cyclone",
+    "cylinder", "cymbal", "cynical", "cypress", "dab", "dabble", "dachshund", "dad", "daffodil", "daffy",
+    "dagger", "dahlia", "daily", "dainty", "dairy", "daisy", "dalmatian", "dam", "damage", "damp", "damsel",
+    "dance", "dancer", "dancing", "dandelion", "dandruff", "danger", "dangle", "dapper", "dappled", "dare",
+    "daredevil", "daring", "dark", "darken", "darkness", "darkroom", "darling", "dart", "dash", "dashboard",
+    "dashing", "data", "database", "date", "dateline", "daughter", "dauntless", "dawdle", "dawn", "day",
+    "daybed", "daybreak", "daycare", "daydream", "daylight", "daytime", "dazzle", "dazzling", "deacon",
+    "deadbolt", "deadline", "deadlock", "deadpan", "deaf", "deal", "dealer", "dealing", "dealmaker", "dear",
+    "debatable", "debate", "debonair", "debrief", "debris", "debt", "debut", "decade", "decanter", "decathlon",
+    "decay", "deceit", "deceive", "decent", "decibel", "decide", "decimal", "decipher", "decisive", "deck",
+    "deckchair", "deckhand", "declare", "decline", "decode", "decor", "decorate", "decorator", "decoy",
+    "decrease", "decrypt", "dedicate", "dedicated", "deduce", "deed", "deep", "deepen", "deer", "deerskin",
+    "deface", "default", "defeat", "defend", "defender", "defense", "defiant", "define", "deflate", "deflect",
+    "defrost", "deft", "defuse", "defy", "degree", "delay", "delegate", "delete", "deli", "delicacy",
+    "delicate", "delight", "delighted", "delirious", "deliver", "delivery", "delta", "deluge", "deluxe",
+    "demand", "demanding", "demeanor", "demise", "democracy", "demure", "denim", "denote", "dense", "dental",
+    "dentist", "dentures", "deny", "depart", "depend", "dependent", "depict", "deploy", "deposit", "depot",
+    "deprive", "depth", "deputy", "derail", "derby", "descend", "descent", "describe", "desert", "deserve",
+    "design", "designer", "desirable", "desire", "desk", "desktop", "dessert", "destined", "destiny", "destroy",
+    "detail", "detect", "detective", "detergent", "determine", "deterrent", "detonate", "detour", "develop",
+    "device", "devote", "devoted", "devotion", "devour", "devout", "dew", "dewdrop", "dexterity", "diagonal",
+    "diagram", "dial", "dialect", "dialogue", "diameter", "diamond", "diaper", "diary", "dice", "dictate",
+    "dictation", "diction", "diesel", "diet", "differ", "diffuse", "digest", "digestion", "digit", "digital",
+    "dignity", "dilemma", "diligence", "diligent", "dill", "dime", "dimension", "dimmer", "dimple", "diner",
+    "dinette", "dinghy", "dingo", "dinner", "dinosaur", "diorama", "dip", "diploma", "diplomacy", "diplomat",
+    "dipper", "direct", "direction", "director", "dirt", "dirty", "disagree", "disarm", "disband", "disclose",
+    "discount", "discover", "discovery", "discreet", "discuss", "disease", "disguise", "dish", "dishcloth",
+    "dishwater", "dismal", "dismiss", "dispatch", "dispel", "dispense", "dispenser", "disperse", "display",
+    "dispute", "dissect", "distance", "distant", "distill", "distiller", "distinct", "district", "disturb",
+    "ditch", "dive", "diver", "diverge", "diversion", "divert", "divide", "divine", "diving", "divulge",
+    "dizzy", "docile", "dock", "dockside", "dockyard", "doctor", "doctrine", "document", "dodge", "doe", "dog",
+    "doghouse", "dogwood", "doldrums", "doll", "dollar", "dollhouse", "dolly", "dolphin", "domain", "dome",
+    "domestic", "domino", "donate", "donkey", "donor", "doodle", "door", "doorbell", "doorknob", "doormat",
+    "doorstep", "doorstop", "doorway", "dorm", "dormant", "dormitory", "dosage", "dose", "dot", "double",
+    "doubt", "doubtful", "dough", "doughnut", "dove", "dovetail", "down", "downbeat", "downcast", "downfall",
+    "downhill", "download", "downpour", "downright", "downriver", "downsize", "downstage", "downtown",
+    "downward", "downwind", "doze", "dozen", "draft", "draftsman", "drag", "dragnet", "dragon", "dragonfly",
+    "dragster", "drain", "drainage", "drainpipe", "drama", "dramatic", "drank", "drape", "drapery", "drastic",
+    "draw", "drawer", "drawing", "dread", "dream", "dreamboat", "dreamer", "dreamland", "dreamlike", "dreamy",
+    "dredge", "drench", "dress", "dresser", "dressing", "drew", "dribble", "dried", "drift", "drifter",
+    "driftwood", "drill", "drink", "drinkable", "drip", "drive", "driver", "driveway", "drizzle", "drizzly",
+    "drone", "drop", "droplet", "dropper", "drought", "drove", "drown", "drugstore", "drum", "drumbeat",
+    "drummer", "drumstick", "dry", "dryer", "drywall", "duck", "duckling", "duckpond", "duckweed", "duct",
+    "due", "duel", "duet", "duffel", "dug", "dugout", "duke", "dulcimer", "dull", "dumbbell", "dummy", "dump",
+    "dumpling", "dune", "dungeon", "dunk", "duo", "duplex", "durable", "during", "dusk", "dusky", "dust",
+    "dustbin", "duster", "dustpan", "dusty", "dutiful", "duty", "duvet", "dwarf", "dwell", "dwelling",
+    "dwindle", "dye", "dynamic", "dynamite", "dynamo", "dynasty", "each", "eager", "eagle", "ear", "earache",
+    "eardrum", "earl", "earlobe", "early", "earmark", "earmuff", "earn", "earnest", "earnings", "earphone",
+    "earring", "earshot", "earth", "earthen", "earthling", "earthly", "earthwork", "earthworm", "earthy",
+    "ease", "easel", "easement", "easily", "east", "eastbound", "eastern", "eastward", "easy", "easygoing",
+    "eat", "eaten", "eatery", "eavesdrop", "ebb", "ebony", "eccentric", "echo", "eclair", "eclectic", "eclipse",
+    "ecology", "economic", "economy", "ecosystem", "edelweiss", "edge", "edgewise", "edible", "edifice", "edit",
+    "edition", "editor", "educate", "educator", "eel", "effect", "effective", "effort", "egg", "eggcup",
+    "eggnog", "eggplant", "eggshell", "egret", "eight", "eighteen", "eighty", "either", "eject", "elapse",
+    "elastic", "elated", "elbow", "elbowroom", "elder", "elderly", "elect", "election", "electric", "electron",
+    "elegant", "elegy", "element", "elephant", "elevate", "elevated", "elevation", "elevator", "eleven", "elf",
+    "elite", "elixir", "elk", "elkhound", "ellipse", "elm", "elongated", "eloquent", "else", "elude", "elusive",
+    "email", "embargo", "embark", "embassy", "embed", "embellish", "ember", "emblem", "embolden", "emboss",
+    "embrace", "embroider", "emcee", "emerald", "emerge", "emergency", "emigrant", "eminent", "emote",
+    "emotion", "empathy", "emperor", "emphasis", "emphatic", "empire", "employ", "employee", "employer",
+    "empower", "empty", "emu", "emulate", "enable", "enact", "enamel", "enchant", "encircle", "enclave",
+    "enclose", "enclosure", "encode", "encompass", "encore", "encounter", "end", "endearing", "endeavor",
+    "endive", "endless", "endlessly", "endorse", "endowment", "endpoint", "endurance", "endure", "enemy",
+    "energetic", "energize", "energy", "enforce", "engage", "engaging", "engine", "engineer", "engrave",
+    "engross", "engulf", "enhance", "enigma", "enjoy", "enjoyable", "enjoyment", "enlarge", "enlist", "enliven",
+    "enormous", "enough", "enrich", "enroll", "ensemble", "ensure", "entail", "entangle", "enter", "entertain",
+    "entire", "entrance", "entree", "entrust", "entry", "entryway", "envelope", "envious", "envision", "envoy",
+    "envy", "enzyme", "ephemeral", "epic", "epilogue", "episode", "epoch", "equal", "equalizer", "equation",
+    "equator", "equinox", "equip", "equipment", "equity", "era", "eradicate", "erasable", "erase", "eraser",
+    "ergonomic", "erode", "errand", "errant", "erratic", "error", "erupt", "escalate", "escalator", "escapade",
+    "escape", "escort", "espresso", "esquire", "essay", "essence", "essential", "establish", "estate", "esteem",
+    "estimate", "estimator", "estuary", "etching", "eternal", "ethereal", "ethics", "etiquette", "euphoria",
+    "evacuate", "evade", "evaluate", "even", "evening", "event", "ever", "everglade", "evergreen", "evermore",
+    "every", "everybody", "everyday", "everyone", "evict", "evidence", "evident", "evil", "evocative", "evoke",
+    "evolve", "ewe", "exact", "exactly", "exactness", "exalt", "exam", "examine", "example", "excavate",
+    "exceed", "excel", "excellent", "except", "exception", "excerpt", "excess", "exchange", "exchanger",
+    "excitable", "excite", "excitedly", "exclaim", "exclude", "exclusive", "excursion", "excuse", "execute",
+    "executive", "exemplary", "exemplify", "exempt", "exercise", "exert", "exhale", "exhaust", "exhibit",
+    "exhibitor", "exist", "exit", "exodus", "exotic", "expand", "expanse", "expansion", "expect", "expedient",
+    "expedite", "expense", "expert", "expertise", "expertly", "expire", "explain", "explainer", "explicit",
+    "explode", "exploit", "explore", "explorer", "exponent", "export", "exporter", "expose", "exposure",
+    "express", "expressly", "exquisite", "extend", "extension", "extent", "exterior", "extra", "extract",
+    "extractor", "extreme", "exuberant", "eye", "eyeball", "eyebrow", "eyeglass", "eyelash", "eyelid",
+    "eyeliner", "eyepiece", "eyesight", "fable", "fabric", "fabricate", "fabulous", "facade", "face",
+    "facecloth", "facet", "facial", "facility", "fact", "faction", "factoid", "factor", "factory", "factual",
+    "faculty", "fade", "fail", "failure", "faint", "fair", "fairly", "fairway", "fairy", "fairyland",
+    "fairytale", "faith", "faithful", "faithless", "fake", "falcon", "fall", "fallow", "false", "falsetto",
+    "fame", "familiar", "family", "famine", "famous", "fan", "fanatic", "fanciful", "fancy", "fanfare", "fang",
+    "fanlight", "fantastic", "fantasy", "far", "fare", "farewell", "farm", "farmer", "farmhand", "farmhouse",
+    "farming", "farmland", "farmstead", "farmyard", "farther", "fashion", "fast", "fastball", "fasten",
+    "fastener", "fatal", "father", "fathom", "fatigue", "faucet", "fault", "fauna", "favor", "favorably",
+    "favorite", "fawn", "fax", "fear", "fearless", "feasible", "feast", "feather", "feathery", "feature",
+    "federal", "fedora", "fee", "feeble", "feed", "feedback", "feel", "feeling", "feet", "feline", "fellow",
+    "felt", "female", "fence", "fencepost", "fencing", "fender", "fennel", "fern", "ferocity", "ferret",
+    "ferry", "ferryboat", "fertile", "fervent", "festival", "festive", "fetch", "fetching", "feudal", "fever",
+    "few", "fiber", "fiction", "fiddle", "fiddler", "fiddling", "fidelity", "field", "fieldwork", "fierce",
+    "fiery", "fiesta", "fifteen", "fifteenth", "fifth", "fifty", "fig", "fight", "fighter", "figment", "figure",
+    "figurine", "filament", "file", "fill", "fillet", "filling", "film", "filmmaker", "filter", "final",
+    "finale", "finalist", "finance", "finch", "find", "finding", "fine", "finesse", "finger", "fingertip",
+    "finish", "finite", "fir", "fire", "fireball", "firefly", "firehouse", "firelight", "fireman", "fireplace",
+    "firepower", "fireproof", "fireside", "firestorm", "firewood", "firework", "firm", "firmly", "first",
+    "firstborn", "fiscal", "fish", "fishbowl", "fisherman", "fishhook", "fishing", "fishnet", "fishpond",
+    "fishtail", "fist", "fit", "fitness", "five", "fix", "fixable", "fixture", "fizz", "flag", "flagpole",
+    "flagship", "flagstaff", "flagstone", "flair", "flake", "flame", "flamingo", "flannel", "flap", "flapjack",
+    "flare", "flash", "flashback", "flashcard", "flashy", "flask", "flat", "flatbed", "flatland", "flatten",
+    "flatware", "flavor", "flavorful", "flaw", "flawless", "flaxen", "flea", "fled", "flee", "fleece", "fleet",
+    "fleeting", "flesh", "flew", "flex", "flexible", "flick", "flicker", "flight", "flimsy", "flinch", "fling",
+    "flint", "flip", "flipper", "flirt", "float", "flock", "flood", "floodgate", "floor", "flop", "floral",
+    "florist", "floss", "flotation", "flotilla", "flounder", "flour", "flourish", "flow", "flowchart", "flower",
+    "flowerbed", "flowerpot", "flown", "flu", "fluency", "fluent", "fluffy", "fluid", "fluke", "flurry",
+    "flush", "flute", "flutter", "fly", "flyaway", "flyer", "flying", "flypaper", "flywheel", "foam", "focal",
+    "focus", "fog", "foggy", "foghorn", "foible", "foil", "fold", "foldable", "folder", "foliage", "folk",
+    "folklore", "follow", "follower", "folly", "fond", "fondant", "fondue", "font", "food", "fool", "foolish",
+    "foot", "football", "footboard", "foothill", "foothold", "footing", "footloose", "footnote", "footpath",
+    "footprint", "footrest", "footstep", "footwear", "for", "forage", "foray", "forbid", "force", "forecast",
+    "forehand", "foreign", "foreman", "foremost", "forensic", "foresee", "foresight", "forest", "forestry",
+    "forever", "foreword", "forge", "forget", "forgive", "forgiving", "forgo", "fork", "form", "formal",
+    "format", "formation", "former", "formula", "forsake", "fort", "forth", "fortify", "fortitude", "fortnight",
+    "fortress", "fortunate", "fortune", "forty", "forum", "forward", "forwarder", "fossil", "foster", "found",
+    "foundry", "fountain", "four", "fourteen", "fox", "foxglove", "foxhole", "foxhound", "foyer", "fracas",
+    "fraction", "fragile", "fragment", "fragrance", "fragrant", "frame", "framework", "frank", "frantic",
+    "frazzle", "freckle", "freckled", "free", "freedom", "freehand", "freestyle", "freeway", "freewheel",
+    "freeze", "freezer", "freezing", "freight", "freighter", "frenzy", "frequent", "fresco", "fresh", "freshen",
+    "freshman", "freshness", "fretful", "friar", "friction", "friday", "fridge", "friend", "frigate", "fright",
+    "frill", "fringe", "frisky", "fritter", "frivolous", "frog", "frolic", "from", "front", "frontier", "frost",
+    "frostbite", "frostily", "frosty", "frown", "frozen", "frugal", "fruit", "fruitcake", "fruitful", "fry",
+    "fudge", "fuel", "full", "fullback", "fullness", "fully", "fumble", "fun", "function", "fund", "funnel",
+    "funnily", "funny", "fur", "furlong", "furnace", "furniture", "furrow", "furry", "fuse", "fusion", "fuss",
+    "futon", "future", "fuzzy", "gadget", "gaffe", "gain", "gainful", "gala", "galaxy", "gale", "gallant",
+    "gallantry", "galleon", "gallery", "galley", "gallon", "gallop", "gallstone", "galoshes", "gambit",
+    "gamble", "game", "gamer", "gaming", "gamut", "gander", "gangplank", "gangway", "gantry", "gap", "garage",
+    "garbage", "garden", "gardener", "gardenia", "gardening", "garland", "garlic", "garment", "garnet",
+    "garnish", "garrison", "garter", "gas", "gasket", "gasoline", "gasp", "gate", "gatehouse", "gateway",
+    "gather", "gathering", "gauge", "gauntlet", "gauze", "gave", "gavel", "gaze", "gazebo", "gazelle",
+    "gazette", "gear", "gearbox", "gearshift", "gecko", "geese", "gel", "gelatin", "gem", "gemstone", "gender",
+    "gene", "genealogy", "general", "generator", "generous", "genius", "genre", "gentle", "gentleman", "gently",
+    "genuine", "geography", "geologist", "geology", "geometry", "geranium", "gerbil", "germinate", "gesture",
+    "get", "getaway", "geyser", "ghost", "ghostly", "giant", "gibbon", "giddy", "gift", "gigabyte", "gigantic",
+    "giggle", "gilded", "gimmick", "ginger", "gingerly", "gingham", "giraffe", "girl", "give", "given", "gizmo",
+    "glacial", "glacier", "glad", "gladiator", "glamour", "glance", "gland", "glare", "glass", "glassful",
+    "glassware", "gleam", "gleeful", "glide", "glider", "glimmer", "glimpse", "glisten", "glitter", "globe",
+    "globule", "glorified", "glorious", "glory", "gloss", "glossary", "glossy", "glove", "glow", "glowing",
+    "glowworm", "glucose", "glue", "gnarled", "gnome", "goal", "goalie", "goalpost", "goat", "goatee", "gobble",
+    "goblet", "goblin", "godsend", "goggles", "gold", "golden", "goldenrod", "goldfish", "goldmine",
+    "goldsmith", "golf", "golfer", "gondola", "gondolier", "gone", "gong", "good", "goodbye", "goodness",
+    "goodwill", "goose", "gopher", "gorge", "gorgeous", "gorilla", "gosling", "gossip", "gourd", "gourmet",
+    "govern", "governess", "governor", "gown", "grab", "grace", "graceful", "grade", "gradient", "gradual",
+    "graduate", "graffiti", "grain", "grainy", "gram", "grammar", "granary", "grand", "grandeur", "grandma",
+    "grandpa", "grandson", "granite", "granola", "grant", "grape", "grapevine", "graph", "graphic", "graphics",
+    "graphite", "grasp", "grass", "grassland", "grassy", "grateful", "gratitude", "gravel", "gravelly",
+    "graveyard", "gravitate", "gravity", "gravy", "gray", "graze", "grease", "great", "greed", "green",
+    "greenback", "greenbelt", "greenery", "greenroom", "greet", "greeting", "gremlin", "grew", "greyhound",
+    "grid", "griddle", "griffin", "grill", "grimace", "grin", "grind", "grip", "grit", "grizzly", "grocer",
+    "grocery", "groom", "groove", "grotto", "ground", "groundhog", "grounding", "groundnut", "group", "grouse",
+    "grove", "grow", "growl", "grown", "grownup", "growth", "grubby", "gruel", "grumpy", "guacamole", "guard",
+    "guardian", "guardrail", "guava", "guess", "guesswork", "guest", "guestbook", "guidance", "guide",
+    "guidebook", "guideline", "guild", "guildhall", "guinea", "guitar", "guitarist", "gulf", "gull", "gullible",
+    "gulp", "gum", "gumball", "gumbo", "gumdrop", "gummy", "gumption", "gumshoe", "gunboat", "gunny", "guppy",
+    "gust", "gusto", "gutsy", "gutter", "guy", "gym", "gymnasium", "gymnast", "habit", "habitable", "habitat",
+    "hacienda", "hack", "haggle", "haiku", "hail", "hailstone", "hair", "hairbrush", "haircut", "hairpin",
+    "hairy", "half", "halfback", "halfway", "halibut", "hall", "hallmark", "hallowed", "hallway", "halo",
+    "halt", "halter", "ham", "hamburger", "hamlet", "hammer", "hammock", "hamper", "hamster", "hand", "handbag",
+    "handball", "handbill", "handbook", "handcart", "handclasp", "handcraft", "handcuff", "handful", "handgrip",
+    "handheld", "handiwork", "handle", "handlebar", "handmade", "handout", "handrail", "handsaw", "handset",
+    "handshake", "handsome", "handstand", "handwork", "handy", "handyman", "hang", "hangar", "hanger",
+    "hangnail", "hangout", "hankering", "haphazard", "happen", "happily", "happy", "harbor", "hard", "hardback",
+    "hardcover", "hardhat", "hardly", "hardship", "hardware", "hardwood", "hardy", "hare", "harebell",
+    "harlequin", "harm", "harmless", "harmonica", "harmonize", "harmony", "harness", "harp", "harpoon", "harsh",
+    "harvest", "harvester", "hash", "haste", "hat", "hatbox", "hatch", "hatchback", "hatchery", "hatchet",
+    "hatchling", "haul", "haunt", "have", "haven", "hawk", "hawthorn", "hay", "hayloft", "hayride", "haystack",
+    "hazard", "haze", "hazel", "hazelnut", "head", "headache", "headband", "headboard", "headdress",
+    "headfirst", "heading", "headlamp", "headlight", "headline", "headlines", "headlong", "headphone",
+    "headpiece", "headrest", "headroom", "headset", "headstand", "headstone", "headway", "heal", "health",
+    "healthful", "healthy", "heap", "hear", "heard", "hearing", "hearsay", "heart", "heartache", "heartbeat",
+    "heartfelt", "hearth", "heartland", "heartwood", "hearty", "heat", "heater", "heather", "heatproof",
+    "heatwave", "heaven", "heavenly", "heavy", "hectare", "hedge", "hedgehog", "hedgerow", "heel", "height",
+    "heir", "heirloom", "held", "helipad", "helium", "helix", "hello", "helmet", "helmsman", "help", "helper",
+    "helpful", "helpline", "hemline", "hemlock", "hemp", "hen", "heptagon", "herald", "heraldry", "herb",
+    "herbal", "herbicide", "herd", "here", "hereafter", "heritage", "hermit", "hero", "heroic", "heron",
+    "hexagon", "hey", "hibiscus", "hiccup", "hidden", "hide", "hideaway", "hideout", "high", "highchair",
+    "highland", "highlight", "highway", "hike", "hiker", "hiking", "hilarious", "hill", "hillside", "hilltop",
+    "hinder", "hindsight", "hinge", "hint", "hip", "hippo", "hire", "historic", "history", "hit", "hitchhike",
+    "hive", "hoarse", "hobby", "hobbyist", "hockey", "hoedown", "hogwash", "hoist", "hold", "holder",
+    "holdover", "holdup", "hole", "holiday", "hollow", "holly", "holster", "holy", "home", "homebody",
+    "homegrown", "homeland", "homemade", "homemaker", "homeowner", "homespun", "homestead", "hometown",
+    "homeward", "homework", "honest", "honey", "honeybee", "honeycomb", "honeydew", "honeymoon", "honeypot",
+    "hood", "hoodie", "hoof", "hook", "hookworm", "hoop", "hop", "hope", "hopeful", "hopefully", "hopscotch",
+    "horde", "horizon", "horn", "hornet", "horror", "horse", "horseback", "horsefly", "horsehair", "horseshoe",
+    "hose", "hosiery", "hospice", "hospital", "host", "hostel", "hot", "hotbed", "hotcake", "hotel", "hothouse",
+    "hotline", "hotplate", "hound", "hour", "hourglass", "house", "houseboat", "household", "housework",
+    "housing", "hover", "how", "however", "howl", "hub", "huddle", "hug", "huge", "hull", "human", "humankind",
+    "humble", "humdrum", "humid", "humor", "humorous", "hump", "humus", "hundred", "hundredth", "hung",
+    "hunger", "hungry", "hunker", "hunt", "hunter", "huntress", "hurdle", "hurdler", "hurrah", "hurricane",
+    "hurry", "hurt", "husband", "hush", "husk", "husky", "hustle", "hut", "hyacinth", "hybrid", "hydrant",
+    "hydrogen", "hyena", "hygiene", "hymn", "hyperlink", "hyphen", "hypnotic", "ice", "iceberg", "iceboat",
+    "icebox", "icicle", "icing", "icon", "icy", "idea", "ideal", "idealist", "identical", "identify",
+    "identity", "idiom", "idiomatic", "idle", "idler", "idol", "idyllic", "igloo", "igneous", "ignite",
+    "ignore", "iguana", "ill", "image", "imagery", "imaginary", "imagine", "imitate", "immense", "immerse",
+    "immortal", "immovable", "immune", "impact", "impair", "impala", "impart", "impish", "implant", "implore",
+    "important", "impose", "impound", "impress", "imprint", "impromptu", "improve", "impulse", "inbound",
+    "incense", "inch", "incline", "inclined", "include", "inclusive", "incognito", "income", "increase",
+    "indeed", "indent", "index", "indexer", "indicate", "indicator", "indigo", "indoor", "indoors", "induce",
+    "industry", "inertia", "infant", "infantry", "infect", "infield", "infinite", "inflate", "inflow", "inform",
+    "informant", "infuse", "infusion", "ingenious", "ingot", "ingrain", "inhabit", "inhale", "inherit",
+    "initial", "inject", "ink", "inkblot", "inkwell", "inland", "inlay", "inlet", "inmate", "inn", "inner",
+    "inning", "innkeeper", "innocent", "input", "inquiry", "inroad", "insect", "insert", "inside", "insider",
+    "insight", "insignia", "insist", "insomnia", "inspect", "inspector", "inspire", "install", "instance",
+    "instant", "instantly", "instead", "instill", "instinct", "insulate", "intact", "intake", "integer",
+    "intend", "intense", "intent", "intercom", "interest", "interior", "interlock", "intern", "internal",
+    "internet", "interval", "into", "intrepid", "intricate", "intrigue", "intuition", "invade", "invent",
+    "invention", "inventive", "inventor", "invest", "investor", "invisible", "invite", "invoice", "involve",
+    "inward", "iodine", "iris", "iron", "ironclad", "ironic", "ironwork", "irrigate", "island", "isle",
+    "isotope", "issue", "itch", "item", "itemize", "itinerary", "ivory", "ivy", "jab", "jackal", "jackdaw",
+    "jacket", "jackpot", "jade", "jaguar", "jailbreak", "jalapeno", "jam", "jamboree", "janitor", "jar",
+    "jargon", "jasmine", "javelin", "jaw", "jawbone", "jaywalk", "jazz", "jealous", "jeans", "jelly",
+    "jellybean", "jersey", "jester", "jet", "jetliner", "jetty", "jewel", "jewelry", "jiffy", "jigsaw",
+    "jingle", "jitterbug", "job", "jobless", "jockey", "jog", "join", "joint", "joke", "jokester", "jolly",
+    "jostle", "journal", "journey", "jovial", "joy", "joyful", "jubilant", "jubilee", "judge", "judgement",
+    "judo", "juggle", "juice", "juicy", "jukebox", "july", "jumble", "jumbo", "jump", "jumper", "jumpsuit",
+    "junction", "june", "jungle", "junior", "juniper", "junk", "junkyard", "jurist", "juror", "jury", "just",
+    "justice", "justify", "jute", "kaftan", "kale", "kangaroo", "karate", "kayak", "kebab", "keen", "keep",
+    "keeper", "keepsake", "kelp", "kennel", "kept", "kernel", "kestrel", "ketchup", "kettle", "key", "keyboard",
+    "keyhole", "keynote", "keypad", "keystone", "keystroke", "khaki", "kick", "kickoff", "kickstand", "kid",
+    "kidney", "kiln", "kilobyte", "kilogram", "kilometer", "kilowatt", "kilt", "kimono", "kind", "kindle",
+    "kindness", "kindred", "kinfolk", "king", "kingdom", "kingpin", "kinship", "kiosk", "kiss", "kit",
+    "kitchen", "kite", "kitten", "kitty", "kiwi", "knack", "knapsack", "knee", "kneecap", "kneel", "knew",
+    "knickers", "knife", "knight", "knit", "knob", "knock", "knockout", "knoll", "knot", "know", "knowingly",
+    "known", "knuckle", "koala", "lab", "label", "labor", "laborer", "labyrinth", "lace", "lack", "lacquer",
+    "lacrosse", "ladder", "ladle", "lady", "ladybird", "ladybug", "lagging", "lagoon", "laid", "lake",
+    "lakefront", "lakeside", "lamb", "lambskin", "laminate", "lamp", "lamplight", "lamppost", "lampshade",
+    "lancer", "land", "landfall", "landfill", "landing", "landlady", "landlord", "landmark", "landmass",
+    "landowner", "landscape", "landslide", "lane", "language", "languid", "lanky", "lantern", "lanyard", "lap",
+    "lapel", "laptop", "larder", "large", "lark", "larkspur", "lasagna", "laser", "lasso", "last", "latch",
+    "late", "later", "latitude", "lattice", "laudable", "laugh", "launch", "laundry", "laureate", "laurel",
+    "lava", "lavatory", "lavender", "lavish", "law", "lawful", "lawmaker", "lawn", "lawnmower", "lawyer", "lay",
+    "layer", "layman", "layout", "lazy", "lead", "leader", "leaf", "leaflet", "leafy", "league", "leak",
+    "leaky", "lean", "leap", "leapfrog", "learn", "learner", "learning", "lease", "leash", "least", "leather",
+    "leave", "lecture", "ledge", "leeway", "left", "leg", "legacy", "legal", "legend", "legendary", "leggings",
+    "legible", "legion", "legume", "leisure", "lemon", "lemonade", "lemur", "lend", "length", "lengthen",
+    "lengthy", "lenient", "lens", "lentil", "leopard", "leotard", "less", "lesson", "let", "letter",
+    "lettering", "lettuce", "level", "lever", "levity", "liaison", "liberal", "liberty", "librarian", "library",
+    "license", "lid", "lie", "life", "lifeblood", "lifeboat", "lifeguard", "lifelike", "lifeline", "lifelong",
+    "lifespan", "lifestyle", "lifetime", "lift", "ligament", "light", "lighten", "lighter", "lightning",
+    "likely", "lilac", "lily", "limb", "lime", "limelight", "limerick", "limestone", "limit", "limitless",
+    "limp", "linchpin", "line", "lineage", "linen", "liner", "lineup", "linger", "linguist", "link", "lion",
+    "lionfish", "lip", "lipstick", "liquid", "lisp", "list", "listen", "listener", "liter", "literacy",
+    "literal", "literary", "little", "live", "lively", "liver", "livestock", "living", "lizard", "llama",
+    "load", "loaf", "loan", "lobby", "lobbyist", "lobster", "local", "locale", "locate", "lock", "locker",
+    "locksmith", "locust", "lodge", "lodging", "loft", "lofty", "log", "logbook", "logic", "logistics",
+    "loiter", "lollipop", "lonely", "long", "longbow", "longhand", "longhorn", "look", "lookout", "loop",
+    "loophole", "loose", "lopsided", "lord", "lose", "loss", "lost", "lot", "lotion", "lottery", "loud",
+    "loudness", "lounge", "love", "lovebird", "lovely", "lover", "low", "lowercase", "lowland", "loyal",
+    "loyalty", "lozenge", "lucid", "luckily", "lucky", "luggage", "lukewarm", "lullaby", "lumber", "luminous",
+    "lumpy", "lunar", "lunch", "lunchbox", "luncheon", "lunchroom", "lung", "lush", "lustrous", "lute",
+    "luxury", "lyric", "lyrical", "macaroni", "macaw", "machine", "mackerel", "mad", "madcap", "made",
+    "maestro", "magazine", "magenta", "magic", "magical", "magician", "magnet", "magnetic", "magnify",
+    "magnolia", "magpie", "mahogany", "maid", "mail", "mailbox", "main", "mainframe", "mainland", "mainsail",
+    "mainstay", "maize", "majestic", "major", "majority", "make", "makeover", "maker", "making", "male", "mall",
+    "mallard", "mallet", "malt", "mammal", "mammoth", "man", "manage", "mandate", "mandatory", "mandolin",
+    "mane", "maneuver", "mango", "mangrove", "manhole", "manhunt", "manicure", "manifest", "manifold",
+    "mankind", "mannequin", "manner", "manor", "mansion", "mantel", "mantis", "mantle", "manual", "many", "map",
+    "maple", "mapmaker", "marathon", "marble", "march", "mare", "margin", "marigold", "marimba", "marina",
+    "marinade", "marine", "maritime", "marjoram", "mark", "marker", "market", "marketer", "marksman",
+    "marmalade", "marmot", "maroon", "marquee", "marry", "marsh", "marshal", "martial", "marvel", "marvelous",
+    "marzipan", "mascot", "mask", "masonry", "mass", "massage", "mast", "master", "masterful", "mastiff",
+    "matador", "match", "matchbox", "matchless", "mate", "material", "math", "matinee", "matriarch", "matrix",
+    "matter", "mattress", "mature", "maverick", "maximum", "may", "maybe", "mayor", "maze", "meadow", "meal",
+    "mealtime", "mean", "meander", "meaning", "meant", "meantime", "meanwhile", "measure", "meat", "mechanic",
+    "mechanism", "medal", "medallion", "meddle", "media", "mediator", "medical", "meditate", "medium", "medley",
+    "meet", "meeting", "megabyte", "megaphone", "melodic", "melodious", "melody", "melon", "melt", "member",
+    "membrane", "memento", "memo", "memorable", "memory", "menagerie", "mend", "mental", "mention", "mentor",
+    "menu", "merchant", "mercury", "mercy", "merge", "meridian", "meringue", "merit", "mermaid", "merrily",
+    "merriment", "merry", "mesh", "mesquite", "mess", "message", "messenger", "metal", "metallic", "metaphor",
+    "meteor", "meteorite", "meter", "method", "metro", "microchip", "midday", "middle", "midfield", "midland",
+    "midnight", "midpoint", "midst", "midstream", "midsummer", "midtown", "midway", "midwinter", "might",
+    "mighty", "migrate", "migration", "mild", "mildew", "mile", "milestone", "military", "milk", "milkman",
+    "milkshake", "milkweed", "mill", "million", "millpond", "millstone", "mimic", "mimosa", "minaret", "mind",
+    "mindful", "mindset", "mine", "miner", "mineral", "miniature", "minibus", "minimum", "ministry", "mink",
+    "minnow", "minor", "minstrel", "mint", "minus", "minute", "miracle", "mirror", "mischief", "miser",
+    "misplace", "miss", "mission", "mist", "mistake", "mister", "mistletoe", "misty", "mitten", "mix", "mixer",
+    "mixture", "moat", "mobile", "mobility", "moccasin", "mode", "model", "modem", "moderate", "moderator",
+    "modern", "modernize", "modest", "module", "mohair", "moist", "moisten", "moisture", "molasses", "mold",
+    "mole", "mollusk", "moment", "momentum", "monarch", "monastery", "monday", "money", "monitor", "monk",
+    "monkey", "monocle", "monogram", "monologue", "monorail", "monsoon", "monster", "month", "monument", "mood",
+    "moon", "moonbeam", "moonlight", "moonlit", "moonrise", "moonshine", "moonstone", "moonwalk", "moorland",
+    "moose", "mop", "moral", "morale", "more", "morning", "morsel", "mortar", "mosaic", "mosquito", "moss",
+    "most", "motel", "moth", "mother", "motion", "motive", "motor", "motorbike", "motorboat", "motorcade",
+    "mound", "mount", "mountable", "mountain", "mouse", "mouth", "mouthful", "mouthwash", "movable", "move",
+    "movie", "moving", "much", "mud", "muddy", "mudflat", "mudroom", "muffin", "muffler", "mug", "mulberry",
+    "mulch", "mule", "mullet", "multiple", "multiply", "multitude", "mumble", "municipal", "muralist", "murmur",
+    "muscle", "museum", "mushroom", "music", "musical", "musician", "musing", "musket", "muskrat", "must",
+    "mustang", "mustard", "mutual", "mutually", "muzzle", "myriad", "myrtle", "myself", "mystery", "myth",
+    "nacho", "nail", "naive", "name", "nanny", "nap", "napkin", "narrate", "narrator", "narrow", "narwhal",
+    "nasal", "nation", "national", "native", "natural", "naturally", "nature", "nautical", "naval", "navigate",
+    "navigator", "navy", "near", "nearby", "nearly", "neat", "nebula", "necessary", "neck", "necklace",
+    "neckline", "nectar", "nectarine", "need", "needful", "needle", "negative", "neglect", "negotiate",
+    "neighbor", "neither", "neon", "nephew", "nerve", "nervous", "nest", "nestled", "nestling", "net",
+    "netting", "nettle", "network", "neutral", "never", "new", "newborn", "newcomer", "news", "newspaper",
+    "newsprint", "newsreel", "newt", "next", "nibble", "nice", "nickel", "nickname", "niece", "night",
+    "nightcap", "nightclub", "nightfall", "nightgown", "nightlife", "nighttime", "nimble", "nimbus", "nine",
+    "ninefold", "nineteen", "ninety", "nitrogen", "nobility", "noble", "nobleman", "nobody", "nocturnal", "nod",
+    "noise", "noisy", "nomad", "nomadic", "nominee", "none", "nonprofit", "nonstop", "noodle", "noodles",
+    "noon", "noontime", "normal", "normalcy", "north", "northern", "nose", "nostalgia", "notable", "notary",
+    "notch", "note", "notebook", "nothing", "notice", "notion", "nourish", "novel", "novelty", "novice", "now",
+    "nowhere", "nozzle", "nuance", "nuclear", "nudge", "nugget", "number", "numeral", "numerous", "nurse",
+    "nursery", "nursing", "nurture", "nut", "nutmeg", "nutrient", "nutrition", "nutshell", "nylon", "oak",
+    "oar", "oarsman", "oasis", "oatcake", "oath", "oatmeal", "obedient", "obey", "object", "objective",
+    "oblige", "oblong", "oboe", "obscure", "observe", "observer", "obsidian", "obtain", "obvious", "occasion",
+    "occupancy", "occupant", "occupy", "occur", "ocean", "ocelot", "octagon", "octave", "october", "octopus",
+    "odd", "oddball", "odor", "odyssey", "offbeat", "offer", "offering", "office", "officer", "offshoot",
+    "offshore", "offspring", "offstage", "often", "oil", "oilcloth", "oilfield", "ointment", "okay", "old",
+    "olive", "omelet", "omit", "onboard", "once", "oncoming", "one", "ongoing", "onion", "online", "onlooker",
+    "only", "onset", "onshore", "onstage", "onward", "onyx", "opal", "opaque", "open", "opening", "opera",
+    "operate", "operator", "opinion", "opossum", "opponent", "oppose", "optic", "optimism", "optimist",
+    "option", "optional", "opulent", "oracle", "oral", "orange", "orangutan", "orator", "orbit", "orbital",
+    "orchard", "orchestra", "orchid", "ordeal", "order", "ordinance", "ordinary", "oregano", "organ", "organic",
+    "organist", "organizer", "organza", "origin", "original", "oriole", "ornament", "ornate", "orthodox",
+    "osprey", "ostrich", "other", "otter", "ought", "ounce", "our", "ourselves", "out", "outboard", "outbound",
+    "outburst", "outcast", "outclass", "outcome", "outcrop", "outdoor", "outer", "outermost", "outfield",
+    "outfit", "outflow", "outgoing", "outgrow", "outhouse", "outing", "outlander", "outlast", "outlaw",
+    "outlet", "outline", "outlook", "outnumber", "outplay", "outpost", "output", "outreach", "outrigger",
+    "outright", "outrun", "outset", "outshine", "outside", "outsider", "outskirts", "outsmart", "outsource",
+    "outspoken", "outstrip", "outward", "outwit", "oval", "oven", "over", "overall", "overbite", "overboard",
+    "overcast", "overcoat", "overcome", "overdue", "overflow", "overgrown", "overhaul", "overhead", "overhear",
+    "overjoyed", "overland", "overlap", "overlay", "overlook", "overnight", "overpass", "overpower", "override",
+    "overrule", "overseas", "oversee", "overseer", "oversight", "oversized", "overtime", "overture", "overview",
+    "owe", "owl", "own", "owner", "ownership", "oxbow", "oxford", "oxidize", "oxygen", "oyster", "ozone",
+    "pace", "pacifier", "pack", "package", "packet", "packhorse", "pact", "pad", "paddle", "paddock", "padlock",
+    "page", "pageant", "pagoda", "paid", "pail", "pain", "painless", "paint", "paintball", "painter",
+    "painting", "pair", "pajamas", "palace", "pale", "palette", "palisade", "pallet", "palm", "palomino",
+    "pamphlet", "pan", "panache", "pancake", "panda", "pandemic", "panel", "panic", "panorama", "pansy", "pant",
+    "panther", "pantry", "paparazzi", "papaya", "paper", "paperback", "paperclip", "paperwork", "papyrus",
+    "parable", "parachute", "parade", "paradise", "paragon", "parakeet", "parallel", "parasol", "parcel",
+    "parchment", "pardon", "parent", "parfait", "park", "parking", "parkland", "parkway", "parlor", "parody",
+    "parrot", "parsley", "parsnip", "part", "particle", "partition", "partner", "party", "pass", "passage",
+    "passenger", "passerby", "passion", "passkey", "passover", "passport", "password", "past", "pasta", "paste",
+    "pastel", "pastime", "pastor", "pastrami", "pastry", "pasture", "pat", "patch", "patchwork", "paternal",
+    "path", "pathway", "patience", "patient", "patio", "patriot", "patrol", "patron", "patronage", "pattern",
+    "pauper", "pause", "pave", "pavement", "pavilion", "paw", "pay", "paycheck", "payment", "pea", "peace",
+    "peaceful", "peacetime", "peach", "peacock", "peak", "peanut", "pear", "pearl", "pebble", "pebbly", "pecan",
+    "peculiar", "pedal", "pedigree", "peel", "peer", "pelican", "pellet", "pen", "penalty", "pencil", "pendant",
+    "pendulum", "penguin", "peninsula", "penknife", "pennant", "penny", "pension", "pentagon", "peony",
+    "pepper", "peppery", "percent", "perch", "peregrine", "perennial", "perfect", "perfectly", "perform",
+    "performer", "perfume", "perhaps", "perimeter", "period", "periscope", "perky", "permanent", "permit",
+    "persimmon", "person", "personal", "persuade", "pet", "petal", "petition", "petticoat", "petunia", "pewter",
+    "phantom", "pharaoh", "pheasant", "phoenix", "phone", "phosphor", "photo", "phrase", "physique", "piano",
+    "piccolo", "pick", "pickaxe", "pickle", "pickup", "picnic", "picture", "pie", "piece", "pier", "pig",
+    "pigeon", "piggyback", "piglet", "pigment", "pigtail", "pile", "pilgrim", "pill", "pillar", "pillbox",
+    "pillow", "pilot", "pinball", "pine", "pineapple", "pinhole", "pink", "pinnacle", "pinpoint", "pinstripe",
+    "pint", "pinwheel", "pioneer", "pipe", "pipeline", "piranha", "pirate", "pistachio", "pit", "pitch",
+    "pitcher", "pitchfork", "pixel", "pizza", "placard", "place", "placid", "plaid", "plain", "plan", "plane",
+    "planet", "plank", "plankton", "plant", "plastic", "plate", "plateau", "platform", "platinum", "platoon",
+    "platter", "platypus", "play", "playback", "playbook", "player", "playful", "playhouse", "playlist",
+    "playmate", "playpen", "playroom", "plaything", "playtime", "plaza", "plea", "plead", "pleasant", "please",
+    "pleasing", "pleasure", "pledge", "plentiful", "plenty", "pliers", "plot", "plow", "pluck", "plug", "plum",
+    "plumage", "plumber", "plumbing", "plummet", "plump", "plunge", "plural", "plus", "plywood", "poacher",
+    "pocket", "pocketful", "podium", "poem", "poet", "poetry", "point", "pointless", "poke", "polar", "pole",
+    "police", "policy", "polish", "polished", "polite", "politely", "polka", "poll", "pollen", "polygon",
+    "pompom", "poncho", "pond", "pondering", "pony", "poodle", "pool", "poolside", "poor", "pop", "popcorn",
+    "popover", "poppy", "popsicle", "popular", "porcelain", "porch", "porcupine", "pork", "porpoise",
+    "porridge", "port", "portable", "portal", "portfolio", "porthole", "portion", "portrait", "pose",
+    "position", "positive", "possible", "post", "postage", "postcard", "poster", "posterior", "postman",
+    "postmark", "postwar", "pot", "potato", "potholder", "potluck", "potpourri", "pottery", "pouch", "poultry",
+    "pound", "pour", "powder", "power", "powerful", "powerless", "powwow", "practical", "practice", "prairie",
+    "praise", "prawn", "pray", "prayer", "preach", "preamble", "precinct", "precise", "predator", "predict",
+    "prefer", "prefix", "prelude", "premiere", "premise", "prepare", "preschool", "present", "presenter",
+    "preserve", "president", "press", "pressure", "presume", "pretender", "pretty", "pretzel", "prevent",
+    "price", "prickly", "pride", "priest", "primary", "primrose", "prince", "princess", "principal", "print",
+    "printer", "printout", "prior", "priority", "prism", "private", "prize", "problem", "procedure", "process",
+    "prodigy", "produce", "product", "professor", "profile", "profiler", "profit", "profound", "program",
+    "progress", "project", "prologue", "promenade", "promise", "promote", "prompt", "promptly", "proof",
+    "propane", "propeller", "proper", "property", "prophet", "proposal", "prospect", "prosper", "protect",
+    "protector", "protein", "protocol", "proton", "prototype", "proud", "prove", "proverb", "provide",
+    "provider", "province", "prowess", "prudent", "public", "publicity", "published", "publisher", "pudding",
+    "puddle", "pueblo", "puff", "puffin", "pull", "pulley", "pullover", "pulsar", "pulse", "puma", "pumice",
+    "pump", "pumpkin", "punch", "punchline", "punctual", "punctuate", "pungent", "pupil", "puppet", "puppy",
+    "purchase", "purchaser", "pure", "purebred", "purify", "purple", "purpose", "purse", "push", "pushcart",
+    "pushover", "put", "putter", "puzzle", "pylon", "pyramid", "python", "quack", "quadrant", "quail", "quaint",
+    "quake", "quality", "quantity", "quarrel", "quarry", "quart", "quarter", "quarterly", "quartet", "quartz",
+    "quasar", "quayside", "queen", "quench", "query", "quest", "question", "questions", "queue", "quibble",
+    "quiche", "quick", "quickness", "quicksand", "quickstep", "quiet", "quietly", "quill", "quilt", "quince",
+    "quinoa", "quintet", "quirky", "quit", "quite", "quiver", "quiz", "quorum", "quota", "quote", "rabbit",
+    "rabble", "raccoon", "race", "racer", "racing", "rack", "racquet", "radar", "radiance", "radiant",
+    "radiator", "radio", "radish", "radius", "raffle", "raft", "rafter", "rag", "rage", "ragtime", "ragweed",
+    "raid", "rail", "railcar", "railing", "railroad", "railway", "rain", "rainbow", "raincoat", "rainfall",
+    "rainstorm", "rainwater", "rainy", "raise", "raisin", "rake", "rally", "ram", "rambler", "ramp", "rampart",
+    "ranch", "rancher", "random", "range", "ranger", "rank", "rapid", "rapture", "rare", "rascal", "rash",
+    "raspberry", "rat", "ratchet", "rate", "rather", "ratio", "rattan", "rattle", "raven", "ravine", "ravioli",
+    "raw", "rawhide", "ray", "razor", "reach", "react", "reactor", "read", "reader", "readiness", "readjust",
+    "readout", "ready", "real", "realistic", "reality", "realm", "reap", "rear", "reason", "rebel", "rebellion",
+    "rebound", "rebuild", "recall", "recapture", "receipt", "receive", "receiver", "recent", "recess",
+    "recharge", "recipe", "recipient", "recital", "reclaim", "recliner", "recluse", "record", "recorder",
+    "recover", "recovery", "rectangle", "recycle", "red", "reduce", "redwood", "reed", "reef", "reentry",
+    "refer", "referee", "reference", "refinance", "refinery", "reflect", "reflector", "reform", "refrain",
+    "refresh", "refresher", "refund", "refuse", "regalia", "regard", "regatta", "region", "regional", "regret",
+    "regular", "rehearsal", "rehearse", "reign", "reindeer", "reinforce", "reject", "relax", "relay", "release",
+    "relevance", "reliable", "relic", "relief", "relish", "rely", "remain", "remaining", "remark", "remedy",
+    "remember", "remind", "remnant", "remote", "remove", "render", "renegade", "renew", "renewal", "rent",
+    "repair", "repeat", "replace", "replica", "reply", "report", "reporter", "reprint", "reptile", "republic",
+    "request", "requiem", "rerun", "rescue", "rescuer", "research", "reserve", "residence", "resident",
+    "resilient", "resin", "resist", "resolute", "resonant", "resort", "resource", "respect", "respond", "rest",
+    "restful", "restore", "result", "retailer", "retina", "retire", "retreat", "retriever", "return", "reunion",
+    "reveal", "revelry", "revenue", "reverend", "reverie", "review", "reviewer", "revision", "revolver",
+    "reward", "rewrite", "rhino", "rhubarb", "rhyme", "rhythm", "rib", "ribbon", "rice", "rich", "ricochet",
+    "riddle", "ride", "rider", "ridge", "rigging", "right", "rigid", "rim", "ring", "ringlet", "ringside",
+    "rinse", "ripe", "ripple", "riptide", "rise", "risk", "ritual", "rival", "river", "riverbank", "riverbed",
+    "riverboat", "road", "roadblock", "roadhouse", "roadmap", "roadside", "roadway", "roadwork", "roam", "roar",
+    "roast", "robe", "robin", "robot", "robust", "rock", "rocker", "rocket", "rockslide", "rocky", "rod",
+    "rodeo", "role", "roll", "roller", "romper", "roof", "rooftop", "rooftops", "rookie", "room", "roomy",
+    "rooster", "root", "rope", "rose", "rosebud", "rosemary", "rosette", "rosewood", "rotate", "rotunda",
+    "rough", "roulette", "round", "roundup", "route", "routine", "row", "rowboat", "royal", "rub", "rubber",
+    "rubble", "ruby", "rudder", "ruffle", "rug", "rugby", "rule", "rulebook", "ruler", "rumble", "rumpus",
+    "run", "runaway", "runner", "runway", "rural", "rush", "rust", "rustic", "rutabaga", "saber", "sack", "sad",
+    "saddle", "saddlebag", "safari", "safe", "safeguard", "safety", "saffron", "saga", "sage", "sagebrush",
+    "said", "sail", "sailboat", "sailcloth", "sailfish", "sailing", "sailor", "saint", "salad", "salary",
+    "sale", "salmon", "salon", "saloon", "salsa", "salt", "saltwater", "salute", "salvage", "samba", "same",
+    "sample", "sanctuary", "sand", "sandal", "sandbag", "sandbar", "sandbox", "sandlot", "sandpaper",
+    "sandpiper", "sandstone", "sandstorm", "sandwich", "sandy", "sane", "sang", "sapling", "sapphire",
+    "sardine", "sarong", "sat", "satchel", "satellite", "satin", "satire", "satisfy", "saturday", "sauce",
+    "saucer", "sausage", "savage", "savanna", "save", "saving", "savor", "savory", "saw", "sawdust", "sawhorse",
+    "sawmill", "saxophone", "say", "scaffold", "scale", "scallion", "scallop", "scamper", "scan", "scare",
+    "scarecrow", "scarf", "scary", "scatter", "scavenger", "scene", "scenery", "scent", "schedule", "scheme",
+    "scholar", "school", "schooner", "science", "scimitar", "scissors", "scoop", "scooter", "scope", "score",
+    "scorecard", "scorpion", "scoundrel", "scout", "scrap", "scrapbook", "scrape", "scrapyard", "scratch",
+    "screen", "screening", "screw", "scribble", "scrimmage", "script", "scroll", "scrub", "scuba", "sculpt",
+    "sculptor", "sculpture", "sea", "seaboard", "seacoast", "seafarer", "seafood", "seafront", "seagull",
+    "seahorse", "seal", "seam", "seamless", "seaplane", "seaport", "search", "seashell", "seashore", "seaside",
+    "season", "seasoning", "seat", "seatbelt", "seaweed", "secluded", "second", "secondary", "secret",
+    "secretary", "section", "sector", "secure", "security", "sedan", "sedentary", "sediment", "see", "seed",
+    "seedling", "seedpod", "seek", "seem", "seen", "seesaw", "segment", "seize", "select", "selection", "self",
+    "sell", "semester", "seminar", "senate", "send", "senior", "sensation", "sense", "sensor", "sent",
+    "sentence", "sentiment", "sentinel", "sequel", "sequin", "serenade", "serene", "sergeant", "series",
+    "serious", "serpent", "servant", "serve", "service", "serving", "sesame", "session", "set", "setback",
+    "settle", "setup", "seven", "seventy", "sever", "sew", "shackle", "shade", "shadow", "shaft", "shake",
+    "shallot", "shallow", "shampoo", "shamrock", "shanty", "shape", "share", "shark", "sharp", "sharpener",
+    "shave", "shawl", "shed", "sheep", "sheepdog", "sheepskin", "sheet", "shelf", "shell", "shellfish",
+    "shelter", "shepherd", "sherbet", "sheriff", "shield", "shift", "shindig", "shine", "shingle", "shiny",
+    "ship", "shipmate", "shipment", "shipowner", "shipshape", "shipyard", "shirt", "shock", "shoe", "shoebox",
+    "shoehorn", "shoelace", "shook", "shoot", "shop", "shopper", "shore", "shoreline", "short", "shortcake",
+    "shortcut", "shortlist", "shortstop", "shot", "should", "shoulder", "shout", "shovel", "show", "showboat",
+    "showcase", "showdown", "shower", "showpiece", "showroom", "shrewd", "shrimp", "shrine", "shrink", "shrub",
+    "shrug", "shuffle", "shut", "shutdown", "shutter", "shy", "sibling", "side", "sidearm", "sidecar",
+    "sideline", "sideshow", "sidestep", "sidewalk", "sideways", "siege", "sift", "sigh", "sight", "sign",
+    "signal", "signature", "signet", "silence", "silent", "silk", "silkworm", "silly", "silo", "silver",
+    "similar", "simmer", "simple", "simulator", "since", "sing", "singalong", "singer", "single", "singsong",
+    "sink", "sip", "siphon", "siren", "sister", "sit", "site", "sitting", "situation", "six", "sixteen",
+    "sixteenth", "sixty", "size", "skate", "skater", "skeleton", "skeptic", "sketch", "ski", "skill", "skillet",
+    "skin", "skip", "skirt", "skull", "sky", "skydiver", "skydiving", "skylark", "skylight", "skyline",
+    "skyward", "slab", "slalom", "slapdash", "slate", "sled", "sleek", "sleep", "sleepy", "sleeve", "sleigh",
+    "slice", "slide", "slideshow", "slight", "slim", "slingshot", "slip", "slipcover", "slipper", "slogan",
+    "slope", "slot", "slow", "slug", "slumber", "small", "smart", "smartness", "smell", "smidgen", "smile",
+    "smoke", "smooth", "smoothie", "snack", "snail", "snake", "snap", "snapshot", "sneak", "sniff", "snorkel",
+    "snow", "snowball", "snowboard", "snowbound", "snowdrift", "snowdrop", "snowfall", "snowflake", "snowman",
+    "snowplow", "snowshoe", "snowstorm", "snowy", "snuggle", "soap", "soapbox", "soapstone", "soccer", "social",
+    "sock", "soda", "sofa", "soft", "softball", "software", "soil", "solace", "solar", "solarium", "soldier",
+    "sole", "solid", "solitaire", "solo", "solstice", "solution", "solve", "sombrero", "some", "someone", "son",
+    "sonar", "sonata", "song", "songbird", "sonnet", "soon", "soprano", "sorbet", "sorcerer", "sort", "sorting",
+    "soul", "soulful", "sound", "soundbar", "soup", "sour", "source", "sourdough", "south", "southward",
+    "souvenir", "soybean", "space", "spaceport", "spaceship", "spacesuit", "spacious", "spade", "spaghetti",
+    "spangle", "spaniel", "spare", "spark", "sparkler", "sparkling", "sparrow", "spatula", "speak", "speaker",
+    "spear", "spearhead", "spearmint", "special", "specimen", "spectrum", "speech", "speed", "speedboat",
+    "spell", "spend", "sphere", "spice", "spider", "spike", "spin", "spinach", "spindle", "spine", "spiral",
+    "spirit", "spiritual", "splash", "splashy", "splendor", "split", "spoil", "spokesman", "sponge", "sponsor",
+    "spoon", "spoonful", "sport", "sportsman", "spot", "spotlight", "spouse", "spray", "spread", "spring",
+    "springbok", "sprint", "sprocket", "sprout", "spruce", "spy", "spyglass", "squad", "squadron", "squall",
+    "square", "squash", "squeeze", "squid", "squire", "squirrel", "stable", "stack", "stadium", "staff",
+    "stage", "stagehand", "stain", "stair", "staircase", "stairway", "stake", "stale", "stalwart", "stamina",
+    "stamp", "stampede", "stand", "staple", "star", "starboard", "stardust", "stare", "starfish", "stargazer",
+    "starlight", "starling", "starship", "start", "state", "stately", "statement", "statesman", "station",
+    "statue", "statuette", "stay", "steadfast", "steady", "steak", "steam", "steamboat", "steamship", "steel",
+    "steep", "steeple", "steer", "stem", "stencil", "step", "stepchild", "stepping", "stereo", "stew", "stick",
+    "sticky", "stiff", "stiletto", "still", "sting", "stingray", "stir", "stock", "stockade", "stockpile",
+    "stockroom", "stoic", "stomach", "stone", "stonework", "stool", "stop", "stopwatch", "storage", "store",
+    "storeroom", "storm", "story", "storybook", "storyline", "stove", "stowaway", "straight", "strange",
+    "strategy", "straw", "stream", "streamer", "street", "strength", "stretch", "strict", "strike", "string",
+    "stripe", "strong", "strongbox", "structure", "strudel", "struggle", "stubborn", "stucco", "student",
+    "studio", "study", "stuff", "stumble", "stump", "sturdy", "style", "subject", "sublime", "submarine",
+    "submit", "subscribe", "subtitle", "suburb", "suburban", "subway", "success", "succulent", "such", "sudden",
+    "suede", "sugar", "sugarcane", "suggest", "suit", "suitable", "suitcase", "sulfur", "sum", "summer",
+    "summit", "sumptuous", "sun", "sunbeam", "sunblock", "sunburn", "sundae", "sunday", "sundial", "sundown",
+    "sunflower", "sunglass", "sunken", "sunlight", "sunny", "sunrise", "sunroof", "sunscreen", "sunset",
+    "sunshine", "super", "superstar", "supply", "support", "supporter", "supreme", "sure", "surface",
+    "surfboard", "surfing", "surge", "surname", "surplus", "surprise", "surprised", "surround", "survey",
+    "survival", "survive", "sushi", "sustain", "swagger", "swallow", "swamp", "swan", "swap", "swarm", "sway",
+    "swear", "sweater", "sweep", "sweet", "sweetcorn", "swell", "swift", "swim", "swimmer", "swimsuit", "swing",
+    "switch", "sword", "swordfish", "sycamore", "syllable", "symbol", "symphony", "symptom", "synopsis",
+    "synthetic", "syrup", "system", "tabby", "table", "tablet", "tabletop", "tableware", "tackle", "taco",
+    "tactic", "taffeta", "taffy", "tag", "tail", "tailgate", "tailor", "tailwind", "take", "takeoff", "takeout",
+    "tale", "talent", "talisman", "talk", "talkative", "tall", "tamale", "tamarind", "tame", "tan", "tandem",
+    "tangelo", "tangerine", "tangle", "tango", "tank", "tap", "tape", "tapestry", "tapeworm", "tapioca",
+    "tarantula", "target", "tarmac", "tarnish", "tarragon", "tartan", "task", "taskbar", "tassel", "taste",
+    "tattoo", "taught", "tavern", "tax", "taxi", "tea", "teach", "teacher", "teacup", "teakettle", "team",
+    "teammate", "teamwork", "tear", "teardrop", "tease", "teaser", "teaspoon", "technical", "technique",
+    "teepee", "teeth", "telegram", "telephone", "telescope", "tell", "telltale", "tempest", "temple", "tempo",
+    "temporary", "ten", "tenacity", "tenant", "tend", "tender", "tendril", "tenfold", "tennis", "tenor", "tent",
+    "tentacle", "term", "terminal", "terrace", "terrain", "terrapin", "terrier", "territory", "test", "text",
+    "textbook", "textile", "texture", "thank", "thankful", "that", "thatch", "thaw", "theater", "theme", "then",
+    "theory", "therapist", "there", "they", "thick", "thicket", "thickness", "thigh", "thimble", "thin",
+    "thing", "think", "thinkable", "thinker", "third", "thirsty", "thirteen", "thirtieth", "thirty", "this",
+    "thistle", "thorn", "those", "though", "thought", "thousand", "thread", "threat", "three", "threefold",
+    "thrifty", "thrill", "thriller", "throat", "throne", "throttle", "through", "throw", "thrush", "thumb",
+    "thunder", "thursday", "thyme", "tiara", "ticket", "tickle", "tidal", "tide", "tideland", "tidewater",
+    "tidy", "tie", "tiger", "tight", "tightrope", "tile", "tilt", "timber", "time", "timeline", "timepiece",
+    "timeshare", "timetable", "timid", "tin", "tinder", "tinderbox", "tinsel", "tiny", "tip", "tiptoe", "tired",
+    "tiresome", "tissue", "titanium", "title", "toad", "toadstool", "toast", "toaster", "toboggan", "today",
+    "toddler", "toe", "toffee", "together", "toilet", "token", "told", "tollbooth", "tomato", "tomorrow", "ton",
+    "tone", "tongue", "tonight", "tool", "toolbox", "toolkit", "tooth", "toothpick", "top", "topaz", "topiary",
+    "topic", "topmost", "topside", "topsoil", "torch", "tornado", "torrent", "tortilla", "tortoise", "toss",
+    "total", "toucan", "touch", "touchdown", "touchline", "tough", "tour", "tourist", "tourney", "toward",
+    "towboat", "towel", "tower", "town", "townhouse", "township", "toy", "trace", "track", "trackball",
+    "tracker", "tractor", "trade", "trademark", "tradesman", "tradition", "traffic", "tragic", "trail",
+    "trailer", "train", "trainee", "trainer", "trait", "tram", "tranquil", "transfer", "transit", "trap",
+    "trapeze", "travel", "trawler", "tray", "treadmill", "treasure", "treat", "treble", "tree", "treetop",
+    "trek", "trellis", "tremor", "trend", "trial", "triangle", "tribe", "tributary", "trick", "trickster",
+    "tricycle", "trident", "trigger", "trim", "trimester", "trimmer", "trinket", "trio", "trip", "triplet",
+    "tripod", "triumph", "trolley", "trombone", "trophy", "trouble", "trousers", "trowel", "truck", "true",
+    "truffle", "truly", "trumpet", "trunk", "trust", "truth", "try", "tube", "tuesday", "tugboat", "tuition",
+    "tulip", "tulle", "tumble", "tumbler", "tuna", "tundra", "tune", "tunnel", "turbine", "turkey", "turn",
+    "turnip", "turnpike", "turnstile", "turntable", "turquoise", "turret", "turtle", "tutor", "tutorial",
+    "tutu", "tuxedo", "twelve", "twenty", "twice", "twig", "twilight", "twin", "twine", "twinkle", "twist",
+    "two", "type", "typhoon", "typical", "ukulele", "ultimate", "umbrella", "umpire", "unable", "unaware",
+    "unbeaten", "unbiased", "unbroken", "uncanny", "unclaimed", "uncle", "uncommon", "uncover", "under",
+    "underarm", "underdog", "underfoot", "undergo", "underline", "underpass", "undersea", "undertow",
+    "underway", "undo", "unearth", "unfair", "unfasten", "unfold", "unfolded", "unhappy", "unhurried",
+    "unicorn", "unicycle", "uniform", "union", "unique", "unison", "unit", "unity", "universe", "unknown",
+    "unless", "unlimited", "unlock", "unlocked", "unpacked", "unravel", "unspoken", "until", "unusual",
+    "unveil", "unwind", "upbeat", "upcoming", "update", "upfront", "upgrade", "upheaval", "uphill", "uphold",
+    "upholster", "upkeep", "upland", "uplift", "uplifting", "upon", "upper", "upright", "uprising", "uproar",
+    "upset", "upside", "upstage", "upstairs", "upstart", "upstream", "uptake", "uptown", "upward", "upwind",
+    "uranium", "urban", "urchin", "urge", "urgency", "usability", "usage", "use", "used", "useful", "useless",
+    "usher", "usual", "utensil", "utility", "utmost", "utopia", "vacancy", "vacant", "vacation", "vacuum",
+    "vagabond", "vague", "valance", "valiant", "valid", "valley", "valor", "valuable", "valve", "van",
+    "vanguard", "vanilla", "vanish", "vantage", "vapor", "variable", "various", "varnish", "vase", "vast",
+    "vault", "vector", "vegetable", "vehicle", "veil", "vein", "velvet", "vendor", "veneer", "venison",
+    "ventilate", "venture", "venue", "veranda", "verb", "verbally", "verbena", "verdict", "verge", "verify",
+    "versatile", "version", "vertex", "vertigo", "very", "vessel", "vest", "veteran", "viable", "viaduct",
+    "vibrant", "vicinity", "victory", "video", "videotape", "view", "viewpoint", "vigilance", "vigilant",
+    "vignette", "vigor", "village", "villager", "vineyard", "vintage", "vintner", "vinyl", "viola", "violet",
+    "violin", "virtual", "virtuoso", "virtuous", "virus", "visa", "visible", "visionary", "visit", "visitor",
+    "vista", "visual", "vital", "vitamin", "vivacious", "vivid", "vocal", "vocalist", "vogue", "voice", "void",
+    "volcanic", "volcano", "volley", "voltage", "volume", "volunteer", "vortex", "vote", "voter", "voucher",
+    "vowel", "voyage", "vulture", "wade", "wafer", "waffle", "wage", "wagon", "wagtail", "waist", "waistcoat",
+    "wait", "waiter", "wake", "wakeful", "walk", "walkabout", "walker", "walkway", "wall", "wallaby", "wallet",
+    "wallpaper", "walnut", "walrus", "wander", "wanderer", "want", "warbler", "ward", "warden", "wardrobe",
+    "wardroom", "warehouse", "warm", "warmly", "warmth", "warn", "warrior", "warthog", "wash", "washbasin",
+    "washboard", "washcloth", "washroom", "wasp", "waste", "wasteland", "watch", "watchdog", "watchful",
+    "water", "waterfall", "waterfowl", "waterline", "watermark", "waterside", "waterway", "wave", "wax",
+    "waxwing", "waxwork", "way", "wayfarer", "wayside", "wayward", "weak", "weakness", "wealth", "wealthy",
+    "wear", "weasel", "weather", "weave", "web", "webcam", "wedding", "wedge", "weed", "week", "weekday",
+    "weekend", "weeknight", "weigh", "weight", "welcome", "welcoming", "welfare", "well", "west", "western",
+    "westward", "wet", "wetland", "whale", "whalebone", "wharf", "what", "wheat", "wheel", "wheelbase", "when",
+    "where", "whichever", "whimsy", "whip", "whirlpool", "whirlwind", "whisker", "whisper", "whistle", "white",
+    "whitewash", "whittle", "whole", "wholesale", "wholesome", "why", "wide", "widget", "width", "wife",
+    "wigwam", "wild", "wildcat", "wildfire", "wildlife", "wildness", "will", "willow", "willpower", "win",
+    "wind", "windbreak", "windfall", "windmill", "window", "windpipe", "windsock", "windstorm", "windward",
+    "wine", "wing", "wingspan", "wink", "winner", "winsome", "winter", "wintry", "wire", "wireless", "wisdom",
+    "wise", "wish", "wishbone", "wisteria", "wistful", "with", "withstand", "witness", "wizard", "wolf",
+    "wolfhound", "woman", "wombat", "wonder", "wonderful", "wood", "woodchuck", "woodcraft", "woodcut",
+    "wooden", "woodland", "woodpile", "woodshed", "woodsman", "woodwind", "woodwork", "wool", "word",
+    "wordplay", "work", "workbench", "workbook", "workday", "worker", "workflow", "workforce", "workhorse",
+    "workload", "workmate", "workplace", "workroom", "workshop", "worktable", "world", "worldly", "worldwide",
+    "worry", "worth", "would", "wound", "wrangler", "wrap", "wrapper", "wreath", "wrench", "wrestle", "wrist",
+    "wristband", "write", "writer", "wrong", "xylophone", "yacht", "yachting", "yachtsman", "yard", "yardstick",
+    "yarn", "yawn", "year", "yearbook", "yearling", "yearning", "yeast", "yellow", "yes", "yesterday", "yield",
+    "yodel", "yoga", "yogurt", "yolk", "young", "youngster", "youth", "yuletide", "zany", "zealous", "zebra",
+    "zenith", "zeppelin", "zero", "zest", "zigzag", "zinc", "zinnia", "zipper", "zodiac", "zone", "zoo",
+    "zookeeper", "zoom", "zucchini"
+  };
+
+  constexpr size_t SIZE = std::size(WORDS);
+  constexpr size_t MAX_LENGTH = 9;
+
+  // Sorted without duplicates, lowercase letters only, at most MAX_LENGTH long
+  constexpr bool wellFormed(){
+    for(size_t i=0; i<SIZE; i++){
+      if(WORDS[i].empty() || WORDS[i].size()>MAX_LENGTH || (i>0 && !(WORDS[i-1]<WORDS[i]))) return false;
+      for(char c : WORDS[i]){
+        if(c<'a' || c>'z') return false;
+      }
+    }
+    return true;
+  }
+
+  static_assert(SIZE==7776 && wellFormed(), "Wordlist must be 7776 sorted, unique, lowercase words");
+}
+#endif